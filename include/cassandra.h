@@ -124,6 +124,17 @@ typedef struct CassDecimal_ {
   CassBytes varint;
 } CassDecimal;
 
+/**
+ * A column resolved by name using cass_prepared_column_index() or
+ * cass_result_column_index(). The members are internal and shouldn't
+ * be modified.
+ */
+typedef struct CassColumnHandle_ {
+  const void* column;
+  cass_size_t index;
+  cass_bool_t is_case_sensitive;
+} CassColumnHandle;
+
 #define CASS_UUID_STRING_LENGTH 37
 
 typedef cass_uint8_t CassUuid[16];
@@ -136,6 +147,7 @@ typedef struct CassFuture_ CassFuture;
 typedef struct CassPrepared_ CassPrepared;
 typedef struct CassResult_ CassResult;
 typedef struct CassIterator_ CassIterator;
+typedef struct CassPageIterator_ CassPageIterator;
 typedef struct CassRow_ CassRow;
 typedef struct CassValue_ CassValue;
 typedef struct CassCollection_ CassCollection;
@@ -190,6 +202,18 @@ typedef enum CassBatchType_ {
   CASS_BATCH_TYPE_COUNTER   = 2
 } CassBatchType;
 
+typedef enum CassRateLimitMode_ {
+  CASS_RATE_LIMIT_MODE_BLOCK, /* Block the calling thread until a permit is available */
+  CASS_RATE_LIMIT_MODE_DELAY, /* Return immediately and delay sending the request */
+  CASS_RATE_LIMIT_MODE_FAIL   /* Fail the request with CASS_ERROR_LIB_RATE_LIMITED */
+} CassRateLimitMode;
+
+typedef enum CassCallbackMode_ {
+  CASS_CALLBACK_MODE_WORK_QUEUE, /* Run callbacks on libuv's shared thread pool */
+  CASS_CALLBACK_MODE_INLINE,     /* Run callbacks on the IO thread that finished the request */
+  CASS_CALLBACK_MODE_EXECUTOR    /* Run callbacks on a driver thread for each IO thread */
+} CassCallbackMode;
+
 typedef enum CassCompression_ {
   CASS_COMPRESSION_NONE   = 0,
   CASS_COMPRESSION_SNAPPY = 1,
@@ -239,6 +263,9 @@ typedef enum  CassErrorSource_ {
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_INVALID_STATEMENT_TYPE, 17, "Invalid statement type") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_NAME_DOES_NOT_EXIST, 18, "No value or column for name") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_UNABLE_TO_DETERMINE_PROTOCOL, 19, "Unable to find supported protocol version") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_REQUEST_CANCELLED, 20, "Request cancelled") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_RATE_LIMITED, 21, "Rate limit exceeded") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_INVALID_COLUMN_HANDLE, 22, "Invalid column handle") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_SERVER_ERROR, 0x0000, "Server error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_PROTOCOL_ERROR, 0x000A, "Protocol error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_BAD_CREDENTIALS, 0x0100, "Bad credentials") \
@@ -277,6 +304,13 @@ typedef void (*CassLogCallback)(cass_uint64_t time,
                                 CassString message,
                                 void* data);
 
+typedef void (*CassValueReleaseCallback)(const cass_byte_t* value,
+                                         cass_size_t size,
+                                         void* data);
+
+typedef void (*CassRowCallback)(const CassRow* row,
+                                void* data);
+
 /***********************************************************************************
  *
  * Cluster
@@ -367,6 +401,42 @@ CASS_EXPORT CassError
 cass_cluster_set_queue_size_io(CassCluster* cluster,
                                unsigned queue_size);
 
+/**
+ * Sets where future callbacks of requests are run.
+ *
+ * CASS_CALLBACK_MODE_WORK_QUEUE runs callbacks on libuv's thread pool,
+ * which is shared with DNS resolution and has four threads by default.
+ *
+ * CASS_CALLBACK_MODE_INLINE runs callbacks on the IO thread that finished
+ * the request. This has the lowest latency, but the IO thread can't
+ * process other requests while a callback runs, so callbacks must be
+ * short and must not block or wait on a future. cass_session_execute() and
+ * cass_session_execute_batch() block when a rate limit in the
+ * CASS_RATE_LIMIT_MODE_BLOCK mode is exceeded, so they must not be called
+ * from a callback in this mode. The requests the driver sends for page
+ * iterators, scatter-gather and scans run their callbacks on libuv's thread
+ * pool in this mode.
+ *
+ * CASS_CALLBACK_MODE_EXECUTOR runs callbacks on a thread the driver
+ * creates for each IO thread. Callbacks of requests finished by the same
+ * IO thread run in order on that thread.
+ *
+ * Callbacks of futures that are already set when the callback is set are
+ * run on the calling thread in every mode.
+ *
+ * Default: CASS_CALLBACK_MODE_WORK_QUEUE
+ *
+ * @param[in] cluster
+ * @param[in] mode
+ * @return CASS_OK if successful, CASS_ERROR_LIB_BAD_PARAMS if the mode
+ * isn't one of the CassCallbackMode values.
+ *
+ * @see cass_future_set_callback()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_callback_mode(CassCluster* cluster,
+                               CassCallbackMode mode);
+
 /**
  * Sets the number of connections made to each server in each
  * IO thread.
@@ -454,7 +524,10 @@ cass_cluster_set_connect_timeout(CassCluster* cluster,
                                  unsigned timeout);
 
 /**
- * Sets the timeout for waiting for a response from a node.
+ * Sets the timeout for waiting for a response from a node. This is
+ * measured from when a request is executed and includes time spent
+ * waiting in the driver's queues and any retries. It can be overridden
+ * per request.
  *
  * Default: 12000 milliseconds
  *
@@ -466,6 +539,169 @@ CASS_EXPORT CassError
 cass_cluster_set_request_timeout(CassCluster* cluster,
                                  unsigned timeout);
 
+/**
+ * Enables adaptive concurrency limiting. The number of requests in-flight
+ * to each host is limited based on the measured latency of the host's
+ * responses. The limit increases while latency stays close to the lowest
+ * recently observed latency and decreases when latency rises or requests
+ * time out. Requests that would exceed a host's limit are sent to the next
+ * host in the query plan.
+ *
+ * Default: false
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_concurrency_limit()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_adaptive_concurrency(CassCluster* cluster,
+                                      cass_bool_t enabled);
+
+/**
+ * Sets the initial and maximum in-flight request limits used by adaptive
+ * concurrency limiting. The limits apply to each host per IO thread.
+ *
+ * Default: 32 (initial), 128 * max_connections_per_host (max)
+ *
+ * @param[in] cluster
+ * @param[in] initial_limit
+ * @param[in] max_limit
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_adaptive_concurrency_limits(CassCluster* cluster,
+                                             unsigned initial_limit,
+                                             unsigned max_limit);
+
+/**
+ * Prepares new statements on every host that's up, not just the host that
+ * handled the PREPARE request. The other hosts are prepared in the
+ * background after the prepared future is set. Otherwise, the first time
+ * a statement is executed on a host it's prepared with an extra round trip.
+ *
+ * Default: true
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_all_hosts(CassCluster* cluster,
+                                      cass_bool_t enabled);
+
+/**
+ * Prepares the session's existing prepared statements on hosts that are
+ * added or come back up (e.g. during a rolling restart). A host doesn't
+ * receive requests until its statements have been prepared.
+ *
+ * Default: true
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
+                                           cass_bool_t enabled);
+
+/**
+ * Saves prepared statements to a file so sessions created after a restart
+ * can use them without preparing them again. The file is read when a
+ * session connects. Statements that are no longer prepared on a host are
+ * prepared again the first time they are executed there.
+ *
+ * Default: "" (Statements are not saved)
+ *
+ * @param[in] cluster
+ * @param[in] path A file writable by the application. Sessions that are
+ * connected at the same time should use different files.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepared_cache_file(CassCluster* cluster,
+                                     const char* path);
+
+/**
+ * Sets the maximum number of prepared statements a session caches. The
+ * least recently prepared statements are evicted first and are prepared
+ * again with an extra round trip if they're needed later.
+ *
+ * Default: 1000
+ *
+ * @param[in] cluster
+ * @param[in] size
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepared_cache_size(CassCluster* cluster,
+                                     unsigned size);
+
+/**
+ * Encodes each request into a single contiguous buffer, sized before it's
+ * encoded and reused after it's written, instead of a list of smaller
+ * buffers. Disabling this is only useful to compare the two encoders.
+ *
+ * Default: true
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_single_buffer_encoding(CassCluster* cluster,
+                                        cass_bool_t enabled);
+
+/**
+ * Limits the rate of requests executed by sessions created from this
+ * cluster using a token bucket. The limit applies to all requests
+ * executed by a session, including those with a request class.
+ *
+ * In the blocking mode only cass_session_execute() and
+ * cass_session_execute_batch() block; requests issued by the driver
+ * itself (paging, scans and scatter-gather) are delayed instead. In the
+ * blocking and delaying modes a request that would be held back longer
+ * than its request timeout fails with CASS_ERROR_LIB_RATE_LIMITED.
+ *
+ * Default: No limit
+ *
+ * @param[in] cluster
+ * @param[in] requests_per_second The rate the bucket refills
+ * @param[in] burst The size of the bucket
+ * @param[in] mode What to do with requests when the bucket is empty
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_rate_limit(CassCluster* cluster,
+                            cass_double_t requests_per_second,
+                            unsigned burst,
+                            CassRateLimitMode mode);
+
+/**
+ * Limits the rate of requests for a user-defined request class. Each
+ * class has its own token bucket in addition to the session's. A request
+ * only takes a permit from either bucket if both have one available.
+ *
+ * Default: No limit
+ *
+ * @param[in] cluster
+ * @param[in] request_class A non-zero identifier
+ * @param[in] requests_per_second The rate the bucket refills
+ * @param[in] burst The size of the bucket
+ * @param[in] mode What to do with requests when the bucket is empty
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_request_class()
+ * @see cass_batch_set_request_class()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_rate_limit_class(CassCluster* cluster,
+                                  unsigned request_class,
+                                  cass_double_t requests_per_second,
+                                  unsigned burst,
+                                  CassRateLimitMode mode);
+
 /**
  * Sets the log level.
  *
@@ -583,7 +819,11 @@ CASS_EXPORT CassFuture*
 cass_session_close(CassSession* session);
 
 /**
- * Create a prepared statement.
+ * Create a prepared statement. Prepared statements are cached by the
+ * session using the query and the session's current keyspace. Preparing a
+ * query that's already being prepared waits for the same request, and
+ * preparing a cached query returns a future that's already set. The
+ * resulting CassPrepared instances are shared.
  *
  * @param[in] session
  * @param[in] query The query is copied into the statement object; the
@@ -622,6 +862,176 @@ CASS_EXPORT CassFuture*
 cass_session_execute_batch(CassSession* session,
                            const CassBatch* batch);
 
+/**
+ * Execute a statement and iterate over all the pages of its result. The
+ * next page is requested as soon as the previous page arrives, without
+ * waiting for the application to consume it. Up to "prefetch_count" pages
+ * are fetched ahead of the application.
+ *
+ * The statement's page size should be set. The statement's paging state
+ * is updated as pages are fetched and the statement must not be changed
+ * or executed until the iterator is freed.
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @param[in] prefetch_count The number of pages fetched ahead (at least 1).
+ * @return A page iterator that must be freed.
+ *
+ * @see cass_statement_set_paging_size()
+ * @see cass_page_iterator_next()
+ */
+CASS_EXPORT CassPageIterator*
+cass_session_execute_paged(CassSession* session,
+                           CassStatement* statement,
+                           cass_size_t prefetch_count);
+
+/**
+ * Reads a whole table by splitting the token ring into ranges and querying
+ * the ranges concurrently. Each range is sent to the host that owns it,
+ * so the scan is spread over the whole cluster. The ring is read from the
+ * "tokens" columns of the "system.local" and "system.peers" tables and
+ * only Murmur3Partitioner is supported.
+ *
+ * The query is run once for each range with the range's restriction
+ * appended, e.g. "SELECT * FROM ks.table" is run as
+ * "SELECT * FROM ks.table WHERE token(pk) > ? AND token(pk) <= ?". All
+ * the pages of a range are read before the next range is started.
+ *
+ * Rows are passed to the callback as they arrive. The callback is called
+ * on the driver's IO threads, possibly at the same time for different
+ * ranges, and must not block.
+ *
+ * @param[in] session
+ * @param[in] query A query without a WHERE clause
+ * @param[in] partition_key The table's partition key columns separated
+ * by commas
+ * @param[in] split_count The number of ranges each token's range is split
+ * into (at least 1)
+ * @param[in] concurrency The maximum number of ranges read at the same time
+ * @param[in] page_size The page size of each range's query, or -1 for no
+ * paging
+ * @param[in] callback
+ * @param[in] data
+ * @return A future that's set when every range has been read. If a range
+ * fails no new ranges are started and the future has the range's error.
+ * Must be freed.
+ *
+ * @see cass_statement_set_row_callback()
+ */
+CASS_EXPORT CassFuture*
+cass_session_scan(CassSession* session,
+                  CassString query,
+                  CassString partition_key,
+                  cass_size_t split_count,
+                  cass_size_t concurrency,
+                  int page_size,
+                  CassRowCallback callback,
+                  void* data);
+
+/**
+ * Executes a prepared single partition statement once for each key and
+ * gathers the results, instead of a single query with an IN restriction
+ * on the partition key. At most "concurrency" requests are in-flight at a
+ * time and each one can use a different coordinator.
+ *
+ * Every request uses the statement's bound values and settings with the
+ * key bound at "key_index". Only the first page of each key's result is
+ * gathered. The statement must not be changed until the future is set.
+ * The keys are read as requests are sent, so "keys" must not be modified
+ * (e.g. by appending more keys) until the future is set. It can be freed
+ * once this returns.
+ *
+ * @param[in] session
+ * @param[in] statement A statement created with cass_prepared_bind()
+ * @param[in] key_index The index the keys are bound to
+ * @param[in] keys A list or set of the keys
+ * @param[in] concurrency The maximum number of requests in-flight
+ * @param[in] preserve_order If true the rows are in the order of the keys,
+ * otherwise they're in the order the results arrived.
+ * @return A future that's set when every key's request has finished. If a
+ * request fails no more requests are sent and the future has the request's
+ * error. If the session is closed before every request is sent the future
+ * has the error CASS_ERROR_LIB_REQUEST_CANCELLED. Must be freed.
+ *
+ * @see cass_iterator_from_future()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute_scatter(CassSession* session,
+                             const CassStatement* statement,
+                             cass_size_t key_index,
+                             const CassCollection* keys,
+                             cass_size_t concurrency,
+                             cass_bool_t preserve_order);
+
+/**
+ * Gets the current adaptive concurrency limit for a host. This is the
+ * sum of the host's limits across all IO threads.
+ *
+ * @param[in] session
+ * @param[in] address The host's IP address
+ * @param[out] limit The current limit, or 0 if adaptive concurrency is
+ * disabled or the host isn't connected.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_adaptive_concurrency()
+ */
+CASS_EXPORT CassError
+cass_session_get_concurrency_limit(CassSession* session,
+                                   const char* address,
+                                   unsigned* limit);
+
+/***********************************************************************************
+ *
+ * Page iterator
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a page iterator. Pages that are still being fetched are discarded.
+ * Results already returned by the iterator must still be freed.
+ *
+ * @param[in] iterator
+ */
+CASS_EXPORT void
+cass_page_iterator_free(CassPageIterator* iterator);
+
+/**
+ * Gets the next page of results. This waits for the page if it hasn't
+ * arrived yet.
+ *
+ * @param[in] iterator
+ * @return The next page. The result must be freed. NULL is returned after
+ * the last page or if an error occurred.
+ *
+ * @see cass_result_free()
+ * @see cass_page_iterator_error_code()
+ */
+CASS_EXPORT const CassResult*
+cass_page_iterator_next(CassPageIterator* iterator);
+
+/**
+ * Gets the error code of a page iterator after cass_page_iterator_next()
+ * returns NULL.
+ *
+ * @param[in] iterator
+ * @return CASS_OK if all pages were returned, otherwise the error that
+ * stopped the iterator. CASS_ERROR_LIB_REQUEST_CANCELLED if the session
+ * was closed before all pages were fetched.
+ */
+CASS_EXPORT CassError
+cass_page_iterator_error_code(CassPageIterator* iterator);
+
+/**
+ * Gets the error message of a page iterator after
+ * cass_page_iterator_next() returns NULL.
+ *
+ * @param[in] iterator
+ * @return Empty string if no error occurred, otherwise a message describing
+ * the error.
+ */
+CASS_EXPORT CassString
+cass_page_iterator_error_message(CassPageIterator* iterator);
+
 /***********************************************************************************
  *
  * Future
@@ -675,6 +1085,22 @@ CASS_EXPORT cass_bool_t
 cass_future_wait_timed(CassFuture* future,
                        cass_duration_t timeout);
 
+/**
+ * Cancels the request associated with the future. The future is
+ * immediately set with the error CASS_ERROR_LIB_REQUEST_CANCELLED and,
+ * if a callback is set, it's run on the calling thread. A request that
+ * hasn't been written yet is never sent. A request that has already been
+ * written has its response discarded without being decoded.
+ *
+ * This has no effect if the future is already set.
+ *
+ * @param[in] future
+ * @return CASS_OK if successful, otherwise an error occurred. Only futures
+ * returned from executing or preparing statements can be cancelled.
+ */
+CASS_EXPORT CassError
+cass_future_cancel(CassFuture* future);
+
 /**
  * Gets the result of a successful future. If the future is not ready this method will
  * wait for the future to be set. The first successful call consumes the future, all
@@ -769,6 +1195,37 @@ cass_statement_new(CassString query,
 CASS_EXPORT void
 cass_statement_free(CassStatement* statement);
 
+/**
+ * Unbinds all the statement's values and clears its paging state so it can
+ * be executed again with new values. The memory used by the previous values
+ * is reused, a statement that's reset and bound in a loop doesn't allocate.
+ * Other settings, like the consistency, are kept.
+ *
+ * This must not be called until the future of the statement's previous
+ * execution has completed.
+ *
+ * @param[in] statement
+ */
+CASS_EXPORT void
+cass_statement_reset(CassStatement* statement);
+
+/**
+ * Freezes a statement so it's encoded once and the same encoded request is
+ * sent every time the statement is executed. This is useful for statements
+ * that are executed repeatedly without changing, e.g. polling a table. A
+ * frozen statement can be executed concurrently from multiple threads.
+ *
+ * The statement's values and settings must not be changed after it's
+ * frozen, changes are not sent. cass_statement_reset() unfreezes the
+ * statement.
+ *
+ * @param[in] statement
+ *
+ * @see cass_statement_reset()
+ */
+CASS_EXPORT void
+cass_statement_freeze(CassStatement* statement);
+
 /**
  * Sets the statement's consistency level.
  *
@@ -808,6 +1265,93 @@ CASS_EXPORT CassError
 cass_statement_set_paging_size(CassStatement* statement,
                                int page_size);
 
+/**
+ * Sets the statement's page size as a number of bytes instead of a number
+ * of rows. The page size sent with the statement is adjusted using the
+ * average size of the rows in the previous pages returned for the
+ * statement, and is always between "min_page_size" and "max_page_size"
+ * rows. The first page uses "min_page_size".
+ *
+ * Pages are only observed when the statement's paging state is set from a
+ * result or when the statement is executed using a page iterator. Pages
+ * passed to a row callback aren't observed.
+ *
+ * Default: 0 (Disabled)
+ *
+ * @param[in] statement
+ * @param[in] page_size_bytes The target page size in bytes, 0 disables
+ * adjusting the page size.
+ * @param[in] min_page_size The minimum page size in rows
+ * @param[in] max_page_size The maximum page size in rows
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_paging_state()
+ * @see cass_session_execute_paged()
+ */
+CASS_EXPORT CassError
+cass_statement_set_paging_size_bytes(CassStatement* statement,
+                                     cass_size_t page_size_bytes,
+                                     int min_page_size,
+                                     int max_page_size);
+
+/**
+ * Sets the statement's request timeout. The timeout starts when the
+ * statement is executed and includes the time spent waiting in the
+ * driver's queues and any retries. Requests that exceed their timeout
+ * before being written are not sent.
+ *
+ * Default: 0 (Use the cluster's request timeout)
+ *
+ * @param[in] statement
+ * @param[in] timeout Request timeout in milliseconds
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_request_timeout()
+ */
+CASS_EXPORT CassError
+cass_statement_set_request_timeout(CassStatement* statement,
+                                   unsigned timeout);
+
+/**
+ * Sets the statement's request class. Requests in a class are subject to
+ * the class's rate limit.
+ *
+ * Default: 0 (No class)
+ *
+ * @param[in] statement
+ * @param[in] request_class
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_rate_limit_class()
+ */
+CASS_EXPORT CassError
+cass_statement_set_request_class(CassStatement* statement,
+                                 unsigned request_class);
+
+/**
+ * Sets a callback that's passed the statement's rows as they're decoded,
+ * while the rest of the response is still arriving. Only a partial row
+ * is buffered so large pages don't need to be held in memory and the
+ * first rows are available sooner. The result returned by the future
+ * has no rows, but its metadata and paging state can still be used.
+ *
+ * The callback is called on one of the driver's IO threads and must not
+ * block. The row is only valid for the duration of the callback. Rows
+ * could be passed to the callback again if the request is retried after
+ * its connection fails.
+ *
+ * Default: NULL (Rows are kept in the result)
+ *
+ * @param[in] statement
+ * @param[in] callback
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_set_row_callback(CassStatement* statement,
+                                CassRowCallback callback,
+                                void* data);
+
 /**
  * Sets the statement's paging state.
  *
@@ -925,6 +1469,55 @@ cass_statement_bind_bytes(CassStatement* statement,
                            cass_size_t index,
                            CassBytes value);
 
+/**
+ * Binds a "ascii", "text" or "varchar" to a query or bound statement
+ * at the specified index without copying it. This is normally reserved
+ * for large values. The value is written to the socket directly from
+ * the application's memory.
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value The memory pointed to by this parameter must not be
+ * modified or freed until the release callback is called.
+ * @param[in] release_callback Called once the driver no longer references
+ * the value: after the statement is freed or the value is replaced and any
+ * requests using it have been written. It's also called if an error is
+ * returned. It can be called on an IO thread. This can be NULL.
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_ref(CassStatement* statement,
+                               cass_size_t index,
+                               CassString value,
+                               CassValueReleaseCallback release_callback,
+                               void* data);
+
+/**
+ * Binds a "blob" or "varint" to a query or bound statement at the specified
+ * index without copying it. This is normally reserved for large values. The
+ * value is written to the socket directly from the application's memory.
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value The memory pointed to by this parameter must not be
+ * modified or freed until the release callback is called.
+ * @param[in] release_callback Called once the driver no longer references
+ * the value: after the statement is freed or the value is replaced and any
+ * requests using it have been written. It's also called if an error is
+ * returned. It can be called on an IO thread. This can be NULL.
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_string_ref()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_ref(CassStatement* statement,
+                              cass_size_t index,
+                              CassBytes value,
+                              CassValueReleaseCallback release_callback,
+                              void* data);
+
 /**
  * Binds a "uuid" or "timeuuid" to a query or bound statement at the specified index.
  *
@@ -989,6 +1582,7 @@ cass_statement_bind_custom(CassStatement* statement,
  * @param[in] statement
  * @param[in] index
  * @param[in] collection The colleciton can be freed after this call.
+ * Elements appended to it afterwards aren't bound.
  * @return CASS_OK if successful, otherwise an error occurred.
  */
 CASS_EXPORT CassError
@@ -1115,8 +1709,8 @@ cass_statement_bind_bytes_by_name(CassStatement* statement,
                                   CassBytes value);
 
 /**
- * Binds a "uuid" or "timeuuid" to all the values
- * with the specified name.
+ * Binds a "ascii", "text" or "varchar" to all the values with the
+ * specified name without copying it.
  *
  * This can only be used with statements created by
  * cass_prepared_bind().
@@ -1124,15 +1718,22 @@ cass_statement_bind_bytes_by_name(CassStatement* statement,
  * @param[in] statement
  * @param[in] name
  * @param[in] value
+ * @param[in] release_callback Called once for all the values.
+ * @param[in] data
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_string_ref()
  */
 CASS_EXPORT CassError
-cass_statement_bind_uuid_by_name(CassStatement* statement,
-                                 const char* name,
-                                 const CassUuid value);
+cass_statement_bind_string_ref_by_name(CassStatement* statement,
+                                       const char* name,
+                                       CassString value,
+                                       CassValueReleaseCallback release_callback,
+                                       void* data);
 
 /**
- * Binds an "inet" to all the values with the specified name.
+ * Binds a "blob" or "varint" to all the values with the specified
+ * name without copying it.
  *
  * This can only be used with statements created by
  * cass_prepared_bind().
@@ -1140,12 +1741,51 @@ cass_statement_bind_uuid_by_name(CassStatement* statement,
  * @param[in] statement
  * @param[in] name
  * @param[in] value
+ * @param[in] release_callback Called once for all the values.
+ * @param[in] data
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes_ref()
  */
 CASS_EXPORT CassError
-cass_statement_bind_inet_by_name(CassStatement* statement,
-                                 const char* name,
-                                 CassInet value);
+cass_statement_bind_bytes_ref_by_name(CassStatement* statement,
+                                      const char* name,
+                                      CassBytes value,
+                                      CassValueReleaseCallback release_callback,
+                                      void* data);
+
+/**
+ * Binds a "uuid" or "timeuuid" to all the values
+ * with the specified name.
+ *
+ * This can only be used with statements created by
+ * cass_prepared_bind().
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_uuid_by_name(CassStatement* statement,
+                                 const char* name,
+                                 const CassUuid value);
+
+/**
+ * Binds an "inet" to all the values with the specified name.
+ *
+ * This can only be used with statements created by
+ * cass_prepared_bind().
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_inet_by_name(CassStatement* statement,
+                                 const char* name,
+                                 CassInet value);
 
 /**
  * Binds a "decimal" to all the values with the specified name.
@@ -1201,6 +1841,268 @@ cass_statement_bind_collection_by_name(CassStatement* statement,
                                        const char* name,
                                        const CassCollection* collection);
 
+/**
+ * Binds an "int" to all the values of a column handle.
+ * This is the same as cass_statement_bind_int32_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_int32_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_int32_by_handle(CassStatement* statement,
+                                    CassColumnHandle handle,
+                                    cass_int32_t value);
+
+/**
+ * Binds a "bigint", "counter" or "timestamp" to all the values of a column handle.
+ * This is the same as cass_statement_bind_int64_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_int64_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_int64_by_handle(CassStatement* statement,
+                                    CassColumnHandle handle,
+                                    cass_int64_t value);
+
+/**
+ * Binds a "float" to all the values of a column handle.
+ * This is the same as cass_statement_bind_float_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_float_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_float_by_handle(CassStatement* statement,
+                                    CassColumnHandle handle,
+                                    cass_float_t value);
+
+/**
+ * Binds a "double" to all the values of a column handle.
+ * This is the same as cass_statement_bind_double_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_double_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_double_by_handle(CassStatement* statement,
+                                     CassColumnHandle handle,
+                                     cass_double_t value);
+
+/**
+ * Binds a "boolean" to all the values of a column handle.
+ * This is the same as cass_statement_bind_bool_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bool_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bool_by_handle(CassStatement* statement,
+                                   CassColumnHandle handle,
+                                   cass_bool_t value);
+
+/**
+ * Binds a "ascii", "text" or "varchar" to all the values of a column handle.
+ * This is the same as cass_statement_bind_string_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_string_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_by_handle(CassStatement* statement,
+                                     CassColumnHandle handle,
+                                     CassString value);
+
+/**
+ * Binds a "blob" to all the values of a column handle.
+ * This is the same as cass_statement_bind_bytes_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_by_handle(CassStatement* statement,
+                                    CassColumnHandle handle,
+                                    CassBytes value);
+
+/**
+ * Binds a "ascii", "text" or "varchar" by reference to all the values of a column handle.
+ * This is the same as cass_statement_bind_string_ref_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @param[in] release_callback
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_string_ref_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_ref_by_handle(CassStatement* statement,
+                                         CassColumnHandle handle,
+                                         CassString value,
+                                         CassValueReleaseCallback release_callback,
+                                         void* data);
+
+/**
+ * Binds a "blob" by reference to all the values of a column handle.
+ * This is the same as cass_statement_bind_bytes_ref_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @param[in] release_callback
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes_ref_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_ref_by_handle(CassStatement* statement,
+                                        CassColumnHandle handle,
+                                        CassBytes value,
+                                        CassValueReleaseCallback release_callback,
+                                        void* data);
+
+/**
+ * Binds a "uuid" or "timeuuid" to all the values of a column handle.
+ * This is the same as cass_statement_bind_uuid_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_uuid_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_uuid_by_handle(CassStatement* statement,
+                                   CassColumnHandle handle,
+                                   const CassUuid value);
+
+/**
+ * Binds an "inet" to all the values of a column handle.
+ * This is the same as cass_statement_bind_inet_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_inet_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_inet_by_handle(CassStatement* statement,
+                                   CassColumnHandle handle,
+                                   CassInet value);
+
+/**
+ * Binds a "decimal" to all the values of a column handle.
+ * This is the same as cass_statement_bind_decimal_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_decimal_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_decimal_by_handle(CassStatement* statement,
+                                      CassColumnHandle handle,
+                                      CassDecimal value);
+
+/**
+ * Binds a custom type to all the values of a column handle.
+ * This is the same as cass_statement_bind_custom_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] size
+ * @param[in] output
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_custom_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_custom_by_handle(CassStatement* statement,
+                                     CassColumnHandle handle,
+                                     cass_size_t size,
+                                     cass_byte_t** output);
+
+/**
+ * Binds a "list", "map" or "set" to all the values of a column handle.
+ * This is the same as cass_statement_bind_collection_by_name(), but the
+ * name is only resolved once.
+ *
+ * @param[in] statement
+ * @param[in] handle A handle from cass_prepared_column_index() for the
+ * prepared statement used to create this statement.
+ * @param[in] collection
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_collection_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_collection_by_handle(CassStatement* statement,
+                                         CassColumnHandle handle,
+                                         const CassCollection* collection);
+
 
 /***********************************************************************************
  *
@@ -1227,6 +2129,25 @@ cass_prepared_free(const CassPrepared* prepared);
 CASS_EXPORT CassStatement*
 cass_prepared_bind(const CassPrepared* prepared);
 
+/**
+ * Resolves the name of a bound value of a prepared statement into a
+ * handle. Binding a value using the handle avoids looking up the name
+ * for every statement. The handle is valid for statements created from
+ * this prepared statement.
+ *
+ * @param[in] prepared
+ * @param[in] name The same rules as cass_statement_bind_int32_by_name()
+ * apply to the name.
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise CASS_ERROR_NAME_DOES_NOT_EXIST.
+ *
+ * @see cass_statement_bind_int32_by_handle()
+ */
+CASS_EXPORT CassError
+cass_prepared_column_index(const CassPrepared* prepared,
+                           const char* name,
+                           CassColumnHandle* output);
+
 /***********************************************************************************
  *
  * Batch
@@ -1264,6 +2185,37 @@ CASS_EXPORT CassError
 cass_batch_set_consistency(CassBatch* batch,
                            CassConsistency consistency);
 
+/**
+ * Sets the batch's request timeout. The timeout starts when the batch
+ * is executed and includes the time spent waiting in the driver's
+ * queues and any retries.
+ *
+ * Default: 0 (Use the cluster's request timeout)
+ *
+ * @param[in] batch
+ * @param[in] timeout Request timeout in milliseconds
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_batch_set_request_timeout(CassBatch* batch,
+                               unsigned timeout);
+
+/**
+ * Sets the batch's request class. Requests in a class are subject to
+ * the class's rate limit.
+ *
+ * Default: 0 (No class)
+ *
+ * @param[in] batch
+ * @param[in] request_class
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_rate_limit_class()
+ */
+CASS_EXPORT CassError
+cass_batch_set_request_class(CassBatch* batch,
+                             unsigned request_class);
+
 /**
  * Adds a statement to a batch.
  *
@@ -1483,6 +2435,44 @@ cass_result_column_type(const CassResult* result,
 CASS_EXPORT const CassRow*
 cass_result_first_row(const CassResult* result);
 
+/**
+ * Resolves the name of a column of the result into a handle. Getting a
+ * column using the handle avoids looking up the name for every row. The
+ * handle can also be used with the rows of the following pages of the
+ * same query.
+ *
+ * @param[in] result
+ * @param[in] name
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise CASS_ERROR_NAME_DOES_NOT_EXIST.
+ *
+ * @see cass_row_get_column_by_handle()
+ */
+CASS_EXPORT CassError
+cass_result_column_index(const CassResult* result,
+                         const char* name,
+                         CassColumnHandle* output);
+
+/**
+ * Gets the row at the specified index of the result. The first call
+ * decodes the offsets of every row in the result so that each following
+ * call is constant time. The values of the returned row reference the
+ * result's data and are valid for the lifetime of the result.
+ *
+ * This function can be called concurrently on the same result from
+ * multiple threads.
+ *
+ * @param[in] result
+ * @param[in] index
+ * @return The row at the specified index. NULL if the index is out of range.
+ *
+ * @see cass_result_first_row()
+ * @see cass_iterator_from_result()
+ */
+CASS_EXPORT const CassRow*
+cass_result_row_at(const CassResult* result,
+                   cass_size_t index);
+
 /**
  * Returns true if there are more pages.
  *
@@ -1492,6 +2482,123 @@ cass_result_first_row(const CassResult* result);
 CASS_EXPORT cass_bool_t
 cass_result_has_more_pages(const CassResult* result);
 
+/**
+ * Gets an "int" column of all the result's rows. The rows are decoded in
+ * a single pass, this is faster than getting each value using an iterator.
+ *
+ * @param[in] result
+ * @param[in] index The column's index.
+ * @param[out] output An array with an element for each row. Null and empty
+ * values are set to zero.
+ * @param[in] count The number of elements in the output array. No more than
+ * cass_result_row_count() elements are set.
+ * @param[out] null_bitmap An array of (count + 7) / 8 bytes. The bit for a
+ * row (byte row / 8, bit row % 8) is set if its value is null or empty.
+ * This can be NULL.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_result_get_column_int32(const CassResult* result,
+                             cass_size_t index,
+                             cass_int32_t* output,
+                             cass_size_t count,
+                             cass_uint8_t* null_bitmap);
+
+/**
+ * Gets a "bigint", "counter" or "timestamp" column of all the result's rows.
+ *
+ * @param[in] result
+ * @param[in] index
+ * @param[out] output
+ * @param[in] count
+ * @param[out] null_bitmap
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_get_column_int32()
+ */
+CASS_EXPORT CassError
+cass_result_get_column_int64(const CassResult* result,
+                             cass_size_t index,
+                             cass_int64_t* output,
+                             cass_size_t count,
+                             cass_uint8_t* null_bitmap);
+
+/**
+ * Gets a "float" column of all the result's rows.
+ *
+ * @param[in] result
+ * @param[in] index
+ * @param[out] output
+ * @param[in] count
+ * @param[out] null_bitmap
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_get_column_int32()
+ */
+CASS_EXPORT CassError
+cass_result_get_column_float(const CassResult* result,
+                             cass_size_t index,
+                             cass_float_t* output,
+                             cass_size_t count,
+                             cass_uint8_t* null_bitmap);
+
+/**
+ * Gets a "double" column of all the result's rows.
+ *
+ * @param[in] result
+ * @param[in] index
+ * @param[out] output
+ * @param[in] count
+ * @param[out] null_bitmap
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_get_column_int32()
+ */
+CASS_EXPORT CassError
+cass_result_get_column_double(const CassResult* result,
+                              cass_size_t index,
+                              cass_double_t* output,
+                              cass_size_t count,
+                              cass_uint8_t* null_bitmap);
+
+/**
+ * Gets a "boolean" column of all the result's rows.
+ *
+ * @param[in] result
+ * @param[in] index
+ * @param[out] output
+ * @param[in] count
+ * @param[out] null_bitmap
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_get_column_int32()
+ */
+CASS_EXPORT CassError
+cass_result_get_column_bool(const CassResult* result,
+                            cass_size_t index,
+                            cass_bool_t* output,
+                            cass_size_t count,
+                            cass_uint8_t* null_bitmap);
+
+/**
+ * Gets a "uuid" or "timeuuid" column of all the result's rows.
+ *
+ * @param[in] result
+ * @param[in] index
+ * @param[out] output
+ * @param[in] count
+ * @param[out] null_bitmap
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_get_column_int32()
+ */
+CASS_EXPORT CassError
+cass_result_get_column_uuid(const CassResult* result,
+                            cass_size_t index,
+                            CassUuid* output,
+                            cass_size_t count,
+                            cass_uint8_t* null_bitmap);
+
 /***********************************************************************************
  *
  * Iterator
@@ -1548,6 +2655,21 @@ cass_iterator_from_collection(const CassValue* value);
 CASS_EXPORT CassIterator*
 cass_iterator_from_map(const CassValue* value);
 
+/**
+ * Creates a new iterator over the rows gathered by a future returned from
+ * cass_session_execute_scatter(). This waits for the future to be set.
+ * The rows are accessed using cass_iterator_get_row().
+ *
+ * @param[in] future
+ * @return A new iterator that must be freed. NULL returned if the future
+ * isn't a scatter future or if it has an error.
+ *
+ * @see cass_session_execute_scatter()
+ * @see cass_iterator_free()
+ */
+CASS_EXPORT CassIterator*
+cass_iterator_from_future(CassFuture* future);
+
 /**
  * Frees an iterator instance.
  *
@@ -1670,6 +2792,19 @@ CASS_EXPORT const CassValue*
 cass_row_get_column_by_name(const CassRow* row,
                             const char* name);
 
+/**
+ * Get the column value for the specified row using a handle from
+ * cass_result_column_index().
+ *
+ * @param[in] row
+ * @param[in] handle
+ * @return The column value for the handle. NULL is returned if the
+ * handle's column is out of range for the row.
+ */
+CASS_EXPORT const CassValue*
+cass_row_get_column_by_handle(const CassRow* row,
+                              CassColumnHandle handle);
+
 /***********************************************************************************
  *
  * Value
@@ -1844,6 +2979,68 @@ cass_value_primary_sub_type(const CassValue* collection);
 CASS_EXPORT CassValueType
 cass_value_secondary_sub_type(const CassValue* collection);
 
+/**
+ * Decodes the items of a list or set of ints into an array. This is faster
+ * than iterating over the collection and getting each item individually.
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least "count" items.
+ * @param[in] count The maximum number of items to decode.
+ * @return The number of items decoded. 0 if the value is not a list or set
+ * of ints or if any of its items is malformed.
+ *
+ * @see cass_value_item_count()
+ */
+CASS_EXPORT cass_size_t
+cass_value_get_items_int32(const CassValue* collection,
+                           cass_int32_t* output,
+                           cass_size_t count);
+
+/**
+ * Same as cass_value_get_items_int32(), but for a list or set of bigints.
+ *
+ * @param[in] collection
+ * @param[out] output
+ * @param[in] count
+ * @return The number of items decoded.
+ *
+ * @see cass_value_get_items_int32()
+ */
+CASS_EXPORT cass_size_t
+cass_value_get_items_int64(const CassValue* collection,
+                           cass_int64_t* output,
+                           cass_size_t count);
+
+/**
+ * Same as cass_value_get_items_int32(), but for a list or set of floats.
+ *
+ * @param[in] collection
+ * @param[out] output
+ * @param[in] count
+ * @return The number of items decoded.
+ *
+ * @see cass_value_get_items_int32()
+ */
+CASS_EXPORT cass_size_t
+cass_value_get_items_float(const CassValue* collection,
+                           cass_float_t* output,
+                           cass_size_t count);
+
+/**
+ * Same as cass_value_get_items_int32(), but for a list or set of doubles.
+ *
+ * @param[in] collection
+ * @param[out] output
+ * @param[in] count
+ * @return The number of items decoded.
+ *
+ * @see cass_value_get_items_int32()
+ */
+CASS_EXPORT cass_size_t
+cass_value_get_items_double(const CassValue* collection,
+                            cass_double_t* output,
+                            cass_size_t count);
+
 
 /***********************************************************************************
  *
@@ -40,6 +40,18 @@ CassError cass_batch_set_consistency(CassBatch* batch,
   return CASS_OK;
 }
 
+CassError cass_batch_set_request_timeout(CassBatch* batch,
+                                         unsigned timeout) {
+  batch->set_request_timeout(timeout);
+  return CASS_OK;
+}
+
+CassError cass_batch_set_request_class(CassBatch* batch,
+                                       unsigned request_class) {
+  batch->set_request_class(request_class);
+  return CASS_OK;
+}
+
 CassError cass_batch_add_statement(CassBatch* batch, CassStatement* statement) {
   batch->add_statement(statement);
   return CASS_OK;
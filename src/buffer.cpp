@@ -26,11 +26,19 @@ Buffer::Buffer(const BufferCollection* collection)
   data_.ref.collection = collection;
 }
 
+Buffer::Buffer(const BufferReference* reference)
+  : size_(IS_REFERENCE) {
+  reference->inc_ref();
+  data_.ref.reference = reference;
+}
+
 Buffer::~Buffer() {
   if (size_ > FIXED_BUFFER_SIZE) {
     data_.ref.array->dec_ref();
   } else if (size_ == IS_COLLECTION) {
     data_.ref.collection->dec_ref();
+  } else if (size_ == IS_REFERENCE) {
+    data_.ref.reference->dec_ref();
   }
 }
 
@@ -39,6 +47,29 @@ const BufferCollection* Buffer::collection() const {
   return static_cast<const BufferCollection*>(data_.ref.collection);
 }
 
+const BufferReference* Buffer::reference() const {
+  assert(is_reference());
+  return data_.ref.reference;
+}
+
+const char* Buffer::encoded_data() const {
+  if (is_reference()) {
+    return data_.ref.reference->data();
+  } else if (is_collection()) {
+    return data_.ref.collection->data();
+  }
+  return data();
+}
+
+size_t Buffer::encoded_size() const {
+  if (is_reference()) {
+    return data_.ref.reference->size();
+  } else if (is_collection()) {
+    return data_.ref.collection->data_size();
+  }
+  return size_;
+}
+
 void Buffer::copy(const Buffer& buffer) {
   BufferRef temp = data_.ref;
 
@@ -48,6 +79,9 @@ void Buffer::copy(const Buffer& buffer) {
   } else if (buffer.size_ == IS_COLLECTION) {
     buffer.data_.ref.collection->inc_ref();
     data_.ref.collection = buffer.data_.ref.collection;
+  } else if (buffer.size_ == IS_REFERENCE) {
+    buffer.data_.ref.reference->inc_ref();
+    data_.ref.reference = buffer.data_.ref.reference;
   } else if (buffer.size_ > 0) {
     memcpy(data_.fixed, buffer.data_.fixed, buffer.size_);
   }
@@ -56,6 +90,8 @@ void Buffer::copy(const Buffer& buffer) {
     temp.array->dec_ref();
   } else if (size_ == IS_COLLECTION) {
     temp.collection->dec_ref();
+  } else if (size_ == IS_REFERENCE) {
+    temp.reference->dec_ref();
   }
 
   size_ = buffer.size_;
@@ -30,7 +30,8 @@ namespace cass {
 class BufferArray : public RefCounted<BufferArray> {
 public:
   BufferArray(size_t size)
-    : data_(new char[size]) {}
+    : data_(new char[size])
+    , capacity_(size) {}
 
   virtual ~BufferArray() {
     delete[] data_;
@@ -39,8 +40,41 @@ public:
   const char* data() const { return data_; }
   char* data() { return data_; }
 
+  size_t capacity() const { return capacity_; }
+
 private:
   char* data_;
+  size_t capacity_;
+};
+
+// Application memory that's written to the socket without being copied. The
+// release callback is called once the driver no longer references it, this
+// can be on an IO worker thread.
+class BufferReference : public RefCounted<BufferReference> {
+public:
+  BufferReference(const cass_byte_t* data, size_t size,
+                  CassValueReleaseCallback release_callback,
+                  void* release_data)
+    : data_(reinterpret_cast<const char*>(data))
+    , size_(size)
+    , release_callback_(release_callback)
+    , release_data_(release_data) {}
+
+  ~BufferReference() {
+    if (release_callback_ != NULL) {
+      release_callback_(reinterpret_cast<const cass_byte_t*>(data_), size_,
+                        release_data_);
+    }
+  }
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  const char* data_;
+  size_t size_;
+  CassValueReleaseCallback release_callback_;
+  void* release_data_;
 };
 
 class BufferCollection;
@@ -74,6 +108,8 @@ public:
 
   Buffer(const BufferCollection* collection);
 
+  Buffer(const BufferReference* reference);
+
   Buffer(const Buffer& buf)
     : size_(IS_EMPTY) {
     copy(buf);
@@ -186,12 +222,35 @@ public:
 
   bool is_collection() const { return size_ == IS_COLLECTION; }
 
+  bool is_reference() const { return size_ == IS_REFERENCE; }
+
+  // Changes the size of the buffer without allocating. This is only possible
+  // if its storage isn't shared and is large enough, the contents are kept.
+  bool reuse(size_t size) {
+    if (size > static_cast<size_t>(FIXED_BUFFER_SIZE) &&
+        size_ > FIXED_BUFFER_SIZE &&
+        data_.ref.array->ref_count() == 1 &&
+        data_.ref.array->capacity() >= size) {
+      size_ = size;
+      return true;
+    }
+    return false;
+  }
+
   const BufferCollection* collection() const;
 
+  const BufferReference* reference() const;
+
+  // The bytes written for a buffer in an encoded request. Referenced
+  // application memory and collection elements are written in place.
+  const char* encoded_data() const;
+  size_t encoded_size() const;
+
 private:
   enum {
     IS_EMPTY = -1,
-    IS_COLLECTION = -2
+    IS_COLLECTION = -2,
+    IS_REFERENCE = -3
   };
 
   char* buffer() {
@@ -210,6 +269,7 @@ private:
   union BufferRef {
     BufferArray* array;
     const BufferCollection* collection;
+    const BufferReference* reference;
   };
 
   union {
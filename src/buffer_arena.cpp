@@ -0,0 +1,83 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "buffer_arena.hpp"
+
+// Blocks are 256 bytes to 64 KB, larger frames are allocated directly
+#define MIN_BLOCK_SIZE_SHIFT 8
+#define NUM_SIZE_CLASSES 9
+#define MAX_FREE_BLOCKS_PER_CLASS 64
+
+namespace cass {
+
+BufferArena::BufferArena()
+  : free_blocks_(NUM_SIZE_CLASSES) {}
+
+BufferArena::~BufferArena() {
+  for (std::vector<BlockVec>::iterator it = free_blocks_.begin(),
+       end = free_blocks_.end(); it != end; ++it) {
+    for (BlockVec::iterator i = it->begin(); i != it->end(); ++i) {
+      delete[] *i;
+    }
+  }
+}
+
+char* BufferArena::allocate(size_t size) {
+  size_t index = size_class(size);
+  if (index >= NUM_SIZE_CLASSES) {
+    return new char[size];
+  }
+
+  BlockVec& blocks = free_blocks_[index];
+  if (blocks.empty()) {
+    return new char[static_cast<size_t>(1) << (index + MIN_BLOCK_SIZE_SHIFT)];
+  }
+
+  char* block = blocks.back();
+  blocks.pop_back();
+  return block;
+}
+
+void BufferArena::release(char* block, size_t size) {
+  size_t index = size_class(size);
+  if (index >= NUM_SIZE_CLASSES ||
+      free_blocks_[index].size() >= MAX_FREE_BLOCKS_PER_CLASS) {
+    delete[] block;
+    return;
+  }
+  free_blocks_[index].push_back(block);
+}
+
+size_t BufferArena::cached_block_count() const {
+  size_t count = 0;
+  for (std::vector<BlockVec>::const_iterator it = free_blocks_.begin(),
+       end = free_blocks_.end(); it != end; ++it) {
+    count += it->size();
+  }
+  return count;
+}
+
+size_t BufferArena::size_class(size_t size) {
+  size_t index = 0;
+  size_t block_size = static_cast<size_t>(1) << MIN_BLOCK_SIZE_SHIFT;
+  while (block_size < size && index < NUM_SIZE_CLASSES) {
+    block_size <<= 1;
+    ++index;
+  }
+  return index;
+}
+
+} // namespace cass
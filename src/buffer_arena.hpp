@@ -0,0 +1,57 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_BUFFER_ARENA_HPP_INCLUDED__
+#define __CASS_BUFFER_ARENA_HPP_INCLUDED__
+
+#include "macros.hpp"
+
+#include <stddef.h>
+#include <vector>
+
+namespace cass {
+
+// A cache of memory blocks used to encode a request frame into a single
+// buffer. Blocks are grouped into power of two size classes and are returned
+// to the arena after the frame has been written so steady state encoding
+// doesn't allocate. Each IO worker has its own arena and it's only used from
+// the IO worker's thread so it's not locked.
+class BufferArena {
+public:
+  BufferArena();
+  ~BufferArena();
+
+  // The block is at least "size" bytes. The same size must be used to
+  // release it.
+  char* allocate(size_t size);
+  void release(char* block, size_t size);
+
+  size_t cached_block_count() const;
+
+private:
+  typedef std::vector<char*> BlockVec;
+
+  static size_t size_class(size_t size);
+
+  std::vector<BlockVec> free_blocks_; // Indexed by size class
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BufferArena);
+};
+
+} // namespace cass
+
+#endif
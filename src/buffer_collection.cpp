@@ -99,30 +99,29 @@ namespace cass {
 int BufferCollection::encode(int version, BufferVec* bufs) const {
   if (version != 1 && version != 2) return -1;
 
-  int value_size = sizeof(uint16_t);
-
-  for (BufferVec::const_iterator it = bufs_.begin(),
-      end = bufs_.end(); it != end; ++it) {
-    value_size += sizeof(uint16_t);
-    value_size += it->size();
-  }
+  // [bytes] = <size> [int] + <n> [short] + <elements>
+  Buffer buf(sizeof(int32_t) + sizeof(uint16_t));
+  size_t pos = buf.encode_int32(0, sizeof(uint16_t) + data_size());
+  buf.encode_uint16(pos, is_map_ ? item_count_ / 2 : item_count_);
+  bufs->push_back(buf);
 
-  int buf_size = sizeof(int32_t) + value_size;
+  // The elements are written directly from the collection
+  bufs->push_back(Buffer(this));
 
-  Buffer buf(buf_size);
+  return encoded_size(version);
+}
 
-  size_t pos = buf.encode_int32(0, value_size);
+int32_t BufferCollection::encoded_size(int version) const {
+  return sizeof(int32_t) + sizeof(uint16_t) + data_size();
+}
 
-  pos = buf.encode_uint16(pos, is_map_ ? bufs_.size() / 2 : bufs_.size());
-  for (BufferVec::const_iterator it = bufs_.begin(),
-      end = bufs_.end(); it != end; ++it) {
-    pos = buf.encode_uint16(pos, it->size());
-    pos = buf.copy(pos, it->data(), it->size());
+char* BufferCollection::encode(int version, char* output) const {
+  char* pos = encode_int32(output, sizeof(uint16_t) + data_size());
+  pos = encode_uint16(pos, is_map_ ? item_count_ / 2 : item_count_);
+  if (data_size() > 0) {
+    memcpy(pos, data(), data_size());
   }
-
-  bufs->push_back(buf);
-
-  return buf_size;
+  return pos + data_size();
 }
 
 }
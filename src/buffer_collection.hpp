@@ -18,23 +18,39 @@
 #define __CASS_BUFFER_COLLECTION_HPP_INCLUDED__
 
 #include "buffer.hpp"
+#include "copy_on_write_ptr.hpp"
 #include "ref_counted.hpp"
+#include "serialization.hpp"
+
+#include <vector>
 
 namespace cass {
 
+// Elements are encoded into a single buffer as they're appended so a bound
+// collection is written as is, without being encoded again for every
+// execution of its statement. Statements are bound to a snapshot that
+// shares the buffer; appending to a collection with snapshots copies the
+// buffer first so a request being written never sees it change.
 class BufferCollection : public RefCounted<BufferCollection> {
 public:
   explicit
   BufferCollection(bool is_map, size_t item_count)
-      : is_map_(is_map) {
-    bufs_.reserve(item_count);
+      : data_(new DataVec())
+      , is_map_(is_map)
+      , item_count_(0) {
+    // <size> [short] + most values are at least this large
+    data_->reserve(item_count * (sizeof(uint16_t) + sizeof(int32_t)));
+  }
+
+  // A collection with the elements appended so far
+  BufferCollection* snapshot() const {
+    return new BufferCollection(*this);
   }
 
 #define APPEND_FIXED_TYPE(DeclType, EncodeType)     \
   void append_##EncodeType(const DeclType& value) { \
-    Buffer buf(sizeof(DeclType));                   \
-    buf.encode_##EncodeType(0, value);              \
-    bufs_.push_back(buf);                           \
+    char* pos = append_item(sizeof(DeclType));      \
+    encode_##EncodeType(pos, value);                \
   }
 
   APPEND_FIXED_TYPE(int32_t, int32)
@@ -42,12 +58,11 @@ public:
   APPEND_FIXED_TYPE(float, float)
   APPEND_FIXED_TYPE(double, double)
   APPEND_FIXED_TYPE(uint8_t, byte)
-#undef BIND_FIXED_TYPE
+#undef APPEND_FIXED_TYPE
 
   void append(const char* value, size_t value_length) {
-    Buffer buf(value_length);
-    buf.copy(0, value, value_length);
-    bufs_.push_back(buf);
+    char* pos = append_item(value_length);
+    memcpy(pos, value, value_length);
   }
 
   void append(const uint8_t* value, size_t value_length) {
@@ -55,27 +70,54 @@ public:
   }
 
   void append(CassUuid value) {
-    Buffer buf(sizeof(CassUuid));
-    buf.copy(0, value, sizeof(CassUuid));
-    bufs_.push_back(buf);
+    char* pos = append_item(sizeof(CassUuid));
+    memcpy(pos, value, sizeof(CassUuid));
   }
 
   void append(int32_t scale, const uint8_t* varint, size_t varint_len) {
-    Buffer buf(sizeof(int32_t) + varint_len);
-    size_t pos = buf.encode_int32(0, scale);
-    buf.copy(pos, varint, varint_len);
-    bufs_.push_back(buf);
+    char* pos = append_item(sizeof(int32_t) + varint_len);
+    pos = encode_int32(pos, scale);
+    memcpy(pos, varint, varint_len);
   }
 
   bool is_map() const { return is_map_; }
 
-  size_t item_count() const { return bufs_.size(); }
+  size_t item_count() const { return item_count_; }
+
+  // The encoded elements: <size> [short] + <value> for each element
+  const char* data() const {
+    const DataVec& data = *data_;
+    return data.empty() ? NULL : &data[0];
+  }
+  size_t data_size() const { return data_->size(); }
 
   int encode(int version, BufferVec* bufs) const;
 
+  // Single buffer encoding of the collection as a [bytes] value
+  int32_t encoded_size(int version) const;
+  char* encode(int version, char* output) const;
+
 private:
-  BufferVec bufs_;
+  typedef std::vector<char> DataVec;
+
+  BufferCollection(const BufferCollection& collection)
+      : RefCounted<BufferCollection>()
+      , data_(collection.data_)
+      , is_map_(collection.is_map_)
+      , item_count_(collection.item_count_) {}
+
+  char* append_item(size_t size) {
+    DataVec& data = *data_;
+    size_t pos = data.size();
+    data.resize(pos + sizeof(uint16_t) + size);
+    encode_uint16(&data[pos], size);
+    ++item_count_;
+    return &data[pos + sizeof(uint16_t)];
+  }
+
+  CopyOnWritePtr<DataVec> data_;
   bool is_map_;
+  size_t item_count_;
 };
 
 } // namespace cass
@@ -0,0 +1,126 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "callback_executor.hpp"
+
+#include "future.hpp"
+#include "scoped_mutex.hpp"
+
+namespace cass {
+
+CallbackExecutor::Queue::Queue()
+  : is_closing(false)
+  , thread_id(0) {
+  uv_mutex_init(&mutex);
+  uv_cond_init(&cond);
+}
+
+CallbackExecutor::Queue::~Queue() {
+  uv_mutex_destroy(&mutex);
+  uv_cond_destroy(&cond);
+}
+
+CallbackExecutor::CallbackExecutor()
+  : queue_(new Queue())
+  , is_running_(false) {}
+
+CallbackExecutor::~CallbackExecutor() {
+  close_and_join();
+}
+
+int CallbackExecutor::init() {
+  queue_->inc_ref(); // Thread reference
+  int rc = uv_thread_create(&thread_, on_run, queue_.get());
+  if (rc == 0) {
+    is_running_ = true;
+  } else {
+    queue_->dec_ref();
+  }
+  return rc;
+}
+
+void CallbackExecutor::submit(Future* future) {
+  {
+    ScopedMutex lock(&queue_->mutex);
+    if (!queue_->is_closing) {
+      bool was_empty = queue_->pending.empty();
+      queue_->pending.push_back(future);
+      if (was_empty) {
+        uv_cond_signal(&queue_->cond);
+      }
+      return;
+    }
+  }
+  // The thread may have already stopped
+  future->run_callback();
+  future->dec_ref();
+}
+
+void CallbackExecutor::close_and_join() {
+  if (!is_running_) return;
+  is_running_ = false;
+
+  bool is_executor_thread = false;
+  {
+    ScopedMutex lock(&queue_->mutex);
+    queue_->is_closing = true;
+    is_executor_thread =
+        queue_->thread_id == static_cast<unsigned long>(uv_thread_self());
+    uv_cond_signal(&queue_->cond);
+  }
+
+  // A thread can't join itself. It stops after the running callback
+  // returns and keeps the queue alive until then.
+  if (!is_executor_thread) {
+    uv_thread_join(&thread_);
+  }
+}
+
+void CallbackExecutor::on_run(void* data) {
+  Queue* queue = static_cast<Queue*>(data);
+  run(queue);
+  queue->dec_ref();
+}
+
+void CallbackExecutor::run(Queue* queue) {
+  {
+    ScopedMutex lock(&queue->mutex);
+    queue->thread_id = static_cast<unsigned long>(uv_thread_self());
+  }
+
+  FutureVec batch;
+  while (true) {
+    {
+      ScopedMutex lock(&queue->mutex);
+      while (queue->pending.empty() && !queue->is_closing) {
+        uv_cond_wait(&queue->cond, lock.get());
+      }
+      if (queue->pending.empty()) {
+        break; // Closing and every callback has run
+      }
+      batch.swap(queue->pending);
+    }
+
+    for (FutureVec::iterator it = batch.begin(),
+         end = batch.end(); it != end; ++it) {
+      (*it)->run_callback();
+      (*it)->dec_ref();
+    }
+    batch.clear();
+  }
+}
+
+} // namespace cass
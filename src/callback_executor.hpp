@@ -0,0 +1,83 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_CALLBACK_EXECUTOR_HPP_INCLUDED__
+#define __CASS_CALLBACK_EXECUTOR_HPP_INCLUDED__
+
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <uv.h>
+
+#include <vector>
+
+namespace cass {
+
+class Future;
+
+// Runs future callbacks on a thread owned by the driver instead of libuv's
+// shared thread pool. Each IO worker has its own executor. Futures are
+// handed off in batches: the thread is only signalled when the queue was
+// empty and it takes every pending future at once.
+class CallbackExecutor {
+public:
+  CallbackExecutor();
+  ~CallbackExecutor();
+
+  int init();
+
+  // The future must be referenced until its callback has run. Callbacks of
+  // futures submitted after the executor is closed run on the calling
+  // thread.
+  void submit(Future* future);
+
+  // Runs the pending callbacks then stops the thread. A callback on the
+  // executor's own thread can close it (e.g. by freeing the session), the
+  // thread isn't joined then and stops by itself after the pending
+  // callbacks.
+  void close_and_join();
+
+private:
+  typedef std::vector<Future*> FutureVec;
+
+  // Shared with the thread so the thread can outlive the executor
+  struct Queue : public RefCounted<Queue> {
+    Queue();
+    ~Queue();
+
+    uv_mutex_t mutex;
+    uv_cond_t cond;
+    FutureVec pending;
+    bool is_closing;
+    unsigned long thread_id;
+  };
+
+  static void on_run(void* data);
+
+  static void run(Queue* queue);
+
+private:
+  uv_thread_t thread_;
+  SharedRefPtr<Queue> queue_;
+  bool is_running_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CallbackExecutor);
+};
+
+} // namespace cass
+
+#endif
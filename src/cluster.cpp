@@ -24,6 +24,12 @@
 
 #include <sstream>
 
+static bool is_valid_rate_limit_mode(CassRateLimitMode mode) {
+  return mode == CASS_RATE_LIMIT_MODE_BLOCK ||
+      mode == CASS_RATE_LIMIT_MODE_DELAY ||
+      mode == CASS_RATE_LIMIT_MODE_FAIL;
+}
+
 extern "C" {
 
 CassCluster* cass_cluster_new() {
@@ -66,6 +72,17 @@ CassError cass_cluster_set_queue_size_io(CassCluster* cluster,
   return CASS_OK;
 }
 
+CassError cass_cluster_set_callback_mode(CassCluster* cluster,
+                                         CassCallbackMode mode) {
+  if (mode != CASS_CALLBACK_MODE_WORK_QUEUE &&
+      mode != CASS_CALLBACK_MODE_INLINE &&
+      mode != CASS_CALLBACK_MODE_EXECUTOR) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_callback_mode(mode);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_contact_points(CassCluster* cluster,
                                           const char* contact_points) {
   size_t length = strlen(contact_points);
@@ -142,6 +159,83 @@ CassError cass_cluster_set_request_timeout(CassCluster* cluster,
   return CASS_OK;
 }
 
+CassError cass_cluster_set_adaptive_concurrency(CassCluster* cluster,
+                                                cass_bool_t enabled) {
+  cluster->config().set_adaptive_concurrency(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_adaptive_concurrency_limits(CassCluster* cluster,
+                                                       unsigned initial_limit,
+                                                       unsigned max_limit) {
+  if (initial_limit == 0 || initial_limit > max_limit) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_concurrency_limits(initial_limit, max_limit);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_prepare_on_all_hosts(CassCluster* cluster,
+                                                cass_bool_t enabled) {
+  cluster->config().set_prepare_on_all_hosts(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
+                                                     cass_bool_t enabled) {
+  cluster->config().set_prepare_on_up_or_add_host(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_prepared_cache_file(CassCluster* cluster,
+                                               const char* path) {
+  cluster->config().set_prepared_cache_file(path);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_prepared_cache_size(CassCluster* cluster,
+                                               unsigned size) {
+  if (size == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_prepared_cache_size(size);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_single_buffer_encoding(CassCluster* cluster,
+                                                  cass_bool_t enabled) {
+  cluster->config().set_single_buffer_encoding(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_rate_limit(CassCluster* cluster,
+                                      cass_double_t requests_per_second,
+                                      unsigned burst,
+                                      CassRateLimitMode mode) {
+  if (requests_per_second <= 0.0 || burst == 0 ||
+      !is_valid_rate_limit_mode(mode)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_rate_limit(
+        cass::RateLimitSettings(requests_per_second, burst, mode));
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_rate_limit_class(CassCluster* cluster,
+                                            unsigned request_class,
+                                            cass_double_t requests_per_second,
+                                            unsigned burst,
+                                            CassRateLimitMode mode) {
+  if (request_class == 0 || requests_per_second <= 0.0 || burst == 0 ||
+      !is_valid_rate_limit_mode(mode)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_rate_limit_class(
+        request_class,
+        cass::RateLimitSettings(requests_per_second, burst, mode));
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_log_level(CassCluster* cluster,
                                      CassLogLevel level) {
   cluster->config().set_log_level(level);
@@ -0,0 +1,86 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "concurrency_limiter.hpp"
+
+#include <algorithm>
+
+#define MIN_LIMIT 1U
+#define BASELINE_WINDOW_SIZE 1000
+// Responses slower than this multiple of the baseline indicate queueing
+#define RTT_TOLERANCE 2.0
+#define BACKOFF_RATIO 0.9
+
+namespace cass {
+
+ConcurrencyLimiter::ConcurrencyLimiter(unsigned initial_limit,
+                                       unsigned max_limit)
+  : limit_(std::max(MIN_LIMIT, std::min(initial_limit, max_limit)))
+  , max_limit_(std::max(MIN_LIMIT, max_limit))
+  , baseline_rtt_us_(0)
+  , window_min_rtt_us_(0)
+  , window_count_(0)
+  , samples_since_decrease_(0) {}
+
+bool ConcurrencyLimiter::on_response(uint64_t rtt_us, size_t in_flight) {
+  rtt_us = std::max<uint64_t>(rtt_us, 1);
+
+  if (baseline_rtt_us_ == 0 || rtt_us < baseline_rtt_us_) {
+    baseline_rtt_us_ = rtt_us;
+  }
+
+  // Periodically reset the baseline to the lowest latency of the last
+  // window so it follows changes in the host or network.
+  if (window_count_ == 0 || rtt_us < window_min_rtt_us_) {
+    window_min_rtt_us_ = rtt_us;
+  }
+  if (++window_count_ >= BASELINE_WINDOW_SIZE) {
+    baseline_rtt_us_ = window_min_rtt_us_;
+    window_count_ = 0;
+  }
+
+  ++samples_since_decrease_;
+
+  if (rtt_us > RTT_TOLERANCE * baseline_rtt_us_) {
+    return decrease();
+  }
+
+  // Only grow the limit when it's actually being used
+  if (2 * in_flight >= limit() && limit_ < max_limit_) {
+    unsigned previous = limit();
+    limit_ = std::min(max_limit_, limit_ + 1.0 / limit_);
+    return limit() != previous;
+  }
+
+  return false;
+}
+
+bool ConcurrencyLimiter::on_timeout() {
+  ++samples_since_decrease_;
+  return decrease();
+}
+
+bool ConcurrencyLimiter::decrease() {
+  if (samples_since_decrease_ < limit()) {
+    return false;
+  }
+  samples_since_decrease_ = 0;
+  unsigned previous = limit();
+  limit_ = std::max(static_cast<double>(MIN_LIMIT), limit_ * BACKOFF_RATIO);
+  return limit() != previous;
+}
+
+} // namespace cass
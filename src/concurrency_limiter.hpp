@@ -0,0 +1,58 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_CONCURRENCY_LIMITER_HPP_INCLUDED__
+#define __CASS_CONCURRENCY_LIMITER_HPP_INCLUDED__
+
+#include "third_party/boost/boost/cstdint.hpp"
+
+#include <stddef.h>
+
+namespace cass {
+
+// Adjusts the number of requests allowed in-flight to a host using the
+// round trip time of its responses (AIMD). The lowest latency seen
+// recently is used as the baseline. While responses come back within a
+// tolerance of the baseline the limit grows by roughly one per window
+// of "limit" responses. When latency rises above the tolerance, or
+// requests time out, the limit is reduced multiplicatively, at most once
+// per window.
+class ConcurrencyLimiter {
+public:
+  ConcurrencyLimiter(unsigned initial_limit, unsigned max_limit);
+
+  unsigned limit() const { return static_cast<unsigned>(limit_); }
+
+  bool is_limited(size_t in_flight) const { return in_flight >= limit(); }
+
+  // Both return true if the value returned by limit() changed
+  bool on_response(uint64_t rtt_us, size_t in_flight);
+  bool on_timeout();
+
+private:
+  bool decrease();
+
+  double limit_;
+  const double max_limit_;
+  uint64_t baseline_rtt_us_;
+  uint64_t window_min_rtt_us_;
+  size_t window_count_;
+  size_t samples_since_decrease_;
+};
+
+} // namespace cass
+
+#endif
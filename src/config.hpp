@@ -19,6 +19,7 @@
 
 #include "auth.hpp"
 #include "cassandra.h"
+#include "rate_limiter.hpp"
 #include "round_robin_policy.hpp"
 
 #include <list>
@@ -38,6 +39,7 @@ public:
       , protocol_version_(2)
       , thread_count_io_(1)
       , queue_size_io_(4096)
+      , callback_mode_(CASS_CALLBACK_MODE_WORK_QUEUE)
       , queue_size_event_(4096)
       , queue_size_log_(4096)
       , core_connections_per_host_(2)
@@ -48,6 +50,14 @@ public:
       , max_simultaneous_requests_threshold_(100)
       , connect_timeout_(5000)
       , request_timeout_(12000)
+      , is_adaptive_concurrency_(false)
+      , initial_concurrency_limit_(32)
+      , max_concurrency_limit_(128 * max_connections_per_host_)
+      , has_explicit_concurrency_limits_(false)
+      , prepare_on_all_hosts_(true)
+      , prepare_on_up_or_add_host_(true)
+      , prepared_cache_size_(1000)
+      , single_buffer_encoding_(true)
       , log_level_(CASS_LOG_WARN)
       , log_callback_(default_log_callback)
       , log_data_(NULL)
@@ -66,6 +76,12 @@ public:
     queue_size_io_ = queue_size;
   }
 
+  CassCallbackMode callback_mode() const { return callback_mode_; }
+
+  void set_callback_mode(CassCallbackMode mode) {
+    callback_mode_ = mode;
+  }
+
   unsigned queue_size_event() const { return queue_size_event_; }
 
   void set_queue_size_event(unsigned queue_size) {
@@ -94,6 +110,11 @@ public:
     if (temp > max_pending_requests_) {
       max_pending_requests_ = temp;
     }
+    // The default limit follows the number of connections, but a limit set
+    // explicitly is never overridden.
+    if (!has_explicit_concurrency_limits_ && temp > max_concurrency_limit_) {
+      max_concurrency_limit_ = temp;
+    }
   }
 
   unsigned max_simultaneous_creation() const {
@@ -136,6 +157,71 @@ public:
     request_timeout_ = timeout;
   }
 
+  bool is_adaptive_concurrency() const { return is_adaptive_concurrency_; }
+
+  void set_adaptive_concurrency(bool is_adaptive_concurrency) {
+    is_adaptive_concurrency_ = is_adaptive_concurrency;
+  }
+
+  unsigned initial_concurrency_limit() const {
+    return initial_concurrency_limit_;
+  }
+
+  unsigned max_concurrency_limit() const { return max_concurrency_limit_; }
+
+  void set_concurrency_limits(unsigned initial_limit, unsigned max_limit) {
+    initial_concurrency_limit_ = initial_limit;
+    max_concurrency_limit_ = max_limit;
+    has_explicit_concurrency_limits_ = true;
+  }
+
+  bool prepare_on_all_hosts() const { return prepare_on_all_hosts_; }
+
+  void set_prepare_on_all_hosts(bool enabled) {
+    prepare_on_all_hosts_ = enabled;
+  }
+
+  bool prepare_on_up_or_add_host() const { return prepare_on_up_or_add_host_; }
+
+  void set_prepare_on_up_or_add_host(bool enabled) {
+    prepare_on_up_or_add_host_ = enabled;
+  }
+
+  const std::string& prepared_cache_file() const {
+    return prepared_cache_file_;
+  }
+
+  void set_prepared_cache_file(const std::string& path) {
+    prepared_cache_file_ = path;
+  }
+
+  unsigned prepared_cache_size() const { return prepared_cache_size_; }
+
+  void set_prepared_cache_size(unsigned size) {
+    prepared_cache_size_ = size;
+  }
+
+  bool single_buffer_encoding() const { return single_buffer_encoding_; }
+
+  void set_single_buffer_encoding(bool enabled) {
+    single_buffer_encoding_ = enabled;
+  }
+
+  const RateLimitSettings& rate_limit() const { return rate_limit_; }
+
+  void set_rate_limit(const RateLimitSettings& settings) {
+    rate_limit_ = settings;
+  }
+
+  const RateLimitSettingsMap& rate_limit_classes() const {
+    return rate_limit_classes_;
+  }
+
+  void set_rate_limit_class(unsigned request_class,
+                            const RateLimitSettings& settings) {
+    rate_limit_classes_[request_class] = settings;
+  }
+
   const ContactPointList& contact_points() const {
     return contact_points_;
   }
@@ -209,6 +295,7 @@ private:
   std::string password_;
   unsigned thread_count_io_;
   unsigned queue_size_io_;
+  CassCallbackMode callback_mode_;
   unsigned queue_size_event_;
   unsigned queue_size_log_;
   unsigned core_connections_per_host_;
@@ -219,6 +306,17 @@ private:
   unsigned max_simultaneous_requests_threshold_;
   unsigned connect_timeout_;
   unsigned request_timeout_;
+  bool is_adaptive_concurrency_;
+  unsigned initial_concurrency_limit_;
+  unsigned max_concurrency_limit_;
+  bool has_explicit_concurrency_limits_;
+  bool prepare_on_all_hosts_;
+  bool prepare_on_up_or_add_host_;
+  std::string prepared_cache_file_;
+  unsigned prepared_cache_size_;
+  bool single_buffer_encoding_;
+  RateLimitSettings rate_limit_;
+  RateLimitSettingsMap rate_limit_classes_;
   CassLogLevel log_level_;
   CassLogCallback log_callback_;
   void* log_data_;
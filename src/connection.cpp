@@ -32,6 +32,7 @@
 #include "register_request.hpp"
 #include "error_response.hpp"
 #include "event_response.hpp"
+#include "get_time.hpp"
 #include "logger.hpp"
 #include "cassandra.h"
 
@@ -137,7 +138,9 @@ Connection::Connection(uv_loop_t* loop, Logger* logger, const Config& config,
     , ssl_handshake_done_(false)
     , version_("3.0.0")
     , event_types_(0)
-    , connect_timer_(NULL) {
+    , connect_timer_(NULL)
+    , buffer_arena_(NULL)
+    , metadata_cache_(NULL) {
   socket_.data = this;
   uv_tcp_init(loop_, &socket_);
 }
@@ -152,6 +155,19 @@ void Connection::connect() {
 }
 
 bool Connection::execute(Handler* handler) {
+  if (handler->is_cancelled()) {
+    handler->on_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request cancelled");
+    return true; // Don't retry
+  }
+
+  uint64_t now = get_monotonic_time_ms();
+  if (handler->is_past_deadline(now)) {
+    // Don't waste a stream or server work on a request nobody is waiting for
+    handler->on_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                      "Request timed out before it could be sent");
+    return true; // Don't retry
+  }
+
   int8_t stream = stream_manager_.acquire_stream(handler);
   if (stream < 0) {
     return false;
@@ -160,7 +176,7 @@ bool Connection::execute(Handler* handler) {
   handler->inc_ref(); // Connection reference
   handler->set_stream(stream);
 
-  if (!handler->encode(protocol_version_, 0x00)) {
+  if (!handler->encode(protocol_version_, 0x00, buffer_arena_)) {
     stream_manager_.release_stream(handler->stream());
     handler->on_error(CASS_ERROR_LIB_MESSAGE_ENCODE,
                       "Operation unsupported by this protocol version");
@@ -176,7 +192,9 @@ bool Connection::execute(Handler* handler) {
   uv_stream_t* sock_stream = copy_cast<uv_tcp_t*, uv_stream_t*>(&socket_);
 
   handler->set_state(Handler::REQUEST_STATE_WRITING);
-  handler->start_timer(loop_, config_.request_timeout(), handler,
+  handler->start_timer(loop_,
+                       handler->remaining_time(now, config_.request_timeout()),
+                       handler,
                        boost::bind(&Connection::on_timeout, this, _1));
   handler->write(sock_stream, handler,
                  boost::bind(&Connection::on_write, this, _1));
@@ -218,6 +236,10 @@ void Connection::consume(char* input, size_t size) {
   int remaining = size;
 
   while (remaining != 0) {
+    // Checked before each part of the body so no rows are streamed after
+    // the request has timed out or was cancelled
+    maybe_stream_rows(response_.get());
+
     int consumed = response_->decode(protocol_version_, buffer, remaining);
     if (consumed <= 0) {
       logger_->error("Connection: Error consuming message on host %s", addr_string_.c_str());
@@ -226,9 +248,14 @@ void Connection::consume(char* input, size_t size) {
       continue;
     }
 
+    if (!response_->is_body_ready()) {
+      maybe_discard_body(response_.get());
+    }
+
     if (response_->is_body_ready()) {
       ScopedPtr<ResponseMessage> response(response_.release());
       response_.reset(new ResponseMessage());
+      response_->set_metadata_cache(metadata_cache_);
 
       logger_->debug(
           "Connection: Consumed message type %s with stream %d, input %lu, remaining %d on host %s",
@@ -250,11 +277,10 @@ void Connection::consume(char* input, size_t size) {
         if (stream_manager_.get_item(response->stream(), handler)) {
           switch (handler->state()) {
             case Handler::REQUEST_STATE_READING:
-              maybe_set_keyspace(response.get());
               pending_requests_.remove(handler);
               handler->stop_timer();
               handler->set_state(Handler::REQUEST_STATE_DONE);
-              handler->on_set(response.get());
+              notify_response(handler, response.get());
               handler->dec_ref();
               break;
 
@@ -262,9 +288,8 @@ void Connection::consume(char* input, size_t size) {
               // There are cases when the read callback will happen
               // before the write callback. If this happens we have
               // to allow the write callback to cleanup.
-              maybe_set_keyspace(response.get());
               handler->set_state(Handler::REQUEST_STATE_READ_BEFORE_WRITE);
-              handler->on_set(response.get());
+              notify_response(handler, response.get());
               break;
 
             case Handler::REQUEST_STATE_TIMEOUT:
@@ -289,6 +314,43 @@ void Connection::consume(char* input, size_t size) {
   }
 }
 
+void Connection::maybe_discard_body(ResponseMessage* response) {
+  // Small bodies are always decoded. It's cheap and it guarantees that the
+  // result of a cancelled "USE <keyspace>" still updates the keyspace.
+  if (!response->is_header_received() ||
+      response->is_body_discarded() ||
+      response->stream() < 0 ||
+      response->length() < MIN_DISCARDED_BODY_SIZE) {
+    return;
+  }
+
+  Handler* handler = NULL;
+  if (stream_manager_.get_item(response->stream(), handler, false) &&
+      handler->is_cancelled()) {
+    response->discard_body();
+  }
+}
+
+void Connection::maybe_stream_rows(ResponseMessage* response) {
+  if (!response->is_header_received() || response->stream() < 0) {
+    return;
+  }
+
+  Handler* handler = NULL;
+  if (stream_manager_.get_item(response->stream(), handler, false)) {
+    handler->maybe_stream_rows(response);
+  }
+}
+
+void Connection::notify_response(Handler* handler, ResponseMessage* response) {
+  if (response->is_body_discarded()) {
+    handler->on_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request cancelled");
+  } else {
+    maybe_set_keyspace(response);
+    handler->on_set(response);
+  }
+}
+
 void Connection::maybe_set_keyspace(ResponseMessage* response) {
   if (response->opcode() == CQL_OPCODE_RESULT) {
     ResultResponse* result =
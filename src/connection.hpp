@@ -43,6 +43,7 @@ class Config;
 class Connecter;
 class EventResponse;
 class Logger;
+class MetadataCache;
 class Request;
 class Timer;
 
@@ -57,6 +58,9 @@ public:
     CONNECTION_STATE_CLOSED
   };
 
+  // The largest "USE <keyspace>" result is well under this size
+  static const int32_t MIN_DISCARDED_BODY_SIZE = 128;
+
   typedef boost::function1<void, EventResponse*> EventCallback;
   typedef boost::function1<void, Connection*> Callback;
 
@@ -96,8 +100,19 @@ public:
     event_callback_ = callback;
   }
 
+  // Requests are encoded into single buffers from the arena. The arena must
+  // outlive the connection and belong to the connection's loop thread.
+  void set_buffer_arena(BufferArena* arena) { buffer_arena_ = arena; }
+
+  // Results share decoded metadata through the cache. The same constraints
+  // as the buffer arena apply.
+  void set_metadata_cache(MetadataCache* cache) {
+    metadata_cache_ = cache;
+    response_->set_metadata_cache(cache);
+  }
+
   size_t available_streams() { return stream_manager_.available_streams(); }
-  size_t pending_request_count() { return pending_requests_.size(); }
+  size_t pending_request_count() const { return pending_requests_.size(); }
 
   void on_write(RequestWriter* writer);
   void on_timeout(RequestTimer* timer);
@@ -138,6 +153,9 @@ private:
 
   void actually_close();
   void consume(char* input, size_t size);
+  void maybe_discard_body(ResponseMessage* response);
+  void maybe_stream_rows(ResponseMessage* response);
+  void notify_response(Handler* handler, ResponseMessage* response);
   void maybe_set_keyspace(ResponseMessage* response);
 
   static void on_connect(Connecter* connecter);
@@ -195,6 +213,8 @@ private:
   int event_types_;
 
   Timer* connect_timer_;
+  BufferArena* buffer_arena_;
+  MetadataCache* metadata_cache_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Connection);
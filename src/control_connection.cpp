@@ -16,6 +16,7 @@
 
 #include "control_connection.hpp"
 
+#include "collection_iterator.hpp"
 #include "constants.hpp"
 #include "event_response.hpp"
 #include "load_balancing.hpp"
@@ -35,11 +36,28 @@
 
 #define HIGHEST_SUPPORTED_PROTOCOL_VERSION 2
 
-#define SELECT_LOCAL "SELECT data_center, rack FROM system.local WHERE key='local'"
-#define SELECT_PEERS "SELECT peer, data_center, rack, rpc_address FROM system.peers"
+#define SELECT_LOCAL "SELECT data_center, rack, tokens FROM system.local WHERE key='local'"
+#define SELECT_PEERS "SELECT peer, data_center, rack, rpc_address, tokens FROM system.peers"
 
 namespace cass {
 
+// Only Murmur3Partitioner tokens are decoded, other partitioners' tokens
+// aren't 64-bit integers.
+static bool decode_tokens(const Value* value, TokenVec* tokens) {
+  CollectionIterator iterator(value);
+  while (iterator.next()) {
+    const BufferPiece& buffer = iterator.value()->buffer();
+    std::istringstream ss(std::string(buffer.data(), buffer.size()));
+    int64_t token;
+    ss >> token;
+    if (ss.fail() || !ss.eof()) {
+      return false;
+    }
+    tokens->push_back(token);
+  }
+  return true;
+}
+
 class ControlStartupQueryPlan : public QueryPlan {
 public:
   ControlStartupQueryPlan(const HostMap& hosts) {
@@ -157,7 +175,7 @@ void ControlConnection::reconnect(bool retry_current_host) {
   connection_->set_close_callback(
         boost::bind(&ControlConnection::on_connection_closed, this, _1));
   connection_->set_event_callback(
-        CASS_EVENT_TOPOLOGY_CHANGE | CASS_EVENT_STATUS_CHANGE,
+        CASS_EVENT_TOPOLOGY_CHANGE | CASS_EVENT_STATUS_CHANGE | CASS_EVENT_SCHEMA_CHANGE,
         boost::bind(&ControlConnection::on_connection_event, this, _1));
   connection_->connect();
 }
@@ -387,6 +405,18 @@ void ControlConnection::update_node_info(SharedRefPtr<Host> host, const Row* row
     host->set_listen_address(listen_address.to_string());
   }
 
+  v = row->get_by_name("tokens");
+  if (v != NULL && !v->is_null()) {
+    TokenVec tokens;
+    if (decode_tokens(v, &tokens)) {
+      session_->update_tokens(host->address(), tokens);
+    } else {
+      logger_->debug("ControlConnection: Unable to decode the tokens of host %s. "
+                     "Only Murmur3Partitioner tokens are supported.",
+                     host->address().to_string().c_str());
+    }
+  }
+
   if ((!rack.empty() && rack != host->rack()) ||
       (!dc.empty() && dc != host->dc())) {
     if (!host->was_just_added()) {
@@ -481,9 +511,10 @@ void ControlConnection::on_connection_event(EventResponse* response) {
           break;
 
         case EventResponse::UPDATED:
-          break;
-
         case EventResponse::DROPPED:
+          // Cached result metadata for prepared statements may be stale
+          session_->on_schema_change(response->keyspace().to_string(),
+                                     response->table().to_string());
           break;
       }
       break;
@@ -33,6 +33,14 @@ int ExecuteRequest::encode_v1(BufferVec* bufs) const {
 
   size_t length = 0;
 
+  Buffer prefix, suffix;
+  if (get_template(version, &prefix, &suffix)) {
+    bufs->push_back(prefix);
+    length += prefix.size() + encode_values(version, bufs);
+    bufs->push_back(suffix);
+    return length + suffix.size();
+  }
+
   const std::string& prepared_id = prepared_->id();
 
     // <id> [short bytes] + <n> [short]
@@ -71,6 +79,20 @@ int ExecuteRequest::encode_v2(BufferVec* bufs) const {
   uint8_t flags = 0;
   size_t length = 0;
 
+  Buffer prefix, suffix;
+  if (get_template(version, &prefix, &suffix)) {
+    bufs->push_back(prefix);
+    length += prefix.size();
+    if (values_count() > 0) {
+      length += encode_values(version, bufs);
+    }
+    if (suffix.size() > 0) {
+      bufs->push_back(suffix);
+      length += suffix.size();
+    }
+    return length;
+  }
+
   const std::string& prepared_id = prepared_->id();
 
     // <id> [short bytes] + <consistency> [short] + <flags> [byte]
@@ -83,7 +105,7 @@ int ExecuteRequest::encode_v2(BufferVec* bufs) const {
     flags |= CASS_QUERY_FLAG_VALUES;
   }
 
-  if (skip_metadata()) {
+  if (skip_metadata() && prepared_->has_valid_result_metadata()) {
     flags |= CASS_QUERY_FLAG_SKIP_METADATA;
   }
 
@@ -142,4 +164,188 @@ int ExecuteRequest::encode_v2(BufferVec* bufs) const {
   return length;
 }
 
+int32_t ExecuteRequest::body_size(int version) const {
+  const std::string& prepared_id = prepared_->id();
+
+  // <id> [short bytes] + <consistency> [short]
+  int32_t size = sizeof(uint16_t) + prepared_id.size() + sizeof(uint16_t);
+
+  if (version == 1) {
+    // <n> [short] + <value_1>...<value_n>
+    int32_t values = values_size(version);
+    if (values < 0) {
+      return values;
+    }
+    return size + sizeof(uint16_t) + values;
+  }
+
+  size += sizeof(uint8_t); // <flags> [byte]
+
+  if (values_count() > 0) { // <values> = <n><value_1>...<value_n>
+    int32_t values = values_size(version);
+    if (values < 0) {
+      return values;
+    }
+    size += sizeof(uint16_t) + values;
+  }
+
+  if (page_size() >= 0) {
+    size += sizeof(int32_t); // [int]
+  }
+
+  if (!paging_state().empty()) {
+    size += sizeof(int32_t) + paging_state().size(); // [bytes]
+  }
+
+  if (serial_consistency() != 0) {
+    size += sizeof(uint16_t); // [short]
+  }
+
+  return size;
+}
+
+char* ExecuteRequest::encode_body(int version, char* output) const {
+  Buffer prefix, suffix;
+  if (get_template(version, &prefix, &suffix)) {
+    memcpy(output, prefix.data(), prefix.size());
+    char* pos = encode_values(version, output + prefix.size());
+    memcpy(pos, suffix.data(), suffix.size());
+    return pos + suffix.size();
+  }
+
+  const std::string& prepared_id = prepared_->id();
+
+  char* pos = encode_string(output, prepared_id.data(), prepared_id.size());
+
+  if (version == 1) {
+    pos = encode_uint16(pos, values_count());
+    pos = encode_values(version, pos);
+    return encode_uint16(pos, consistency());
+  }
+
+  pos = encode_uint16(pos, consistency());
+  pos = encode_byte(pos, flags());
+
+  if (values_count() > 0) {
+    pos = encode_uint16(pos, values_count());
+    pos = encode_values(version, pos);
+  }
+
+  if (page_size() >= 0) {
+    pos = encode_int32(pos, page_size());
+  }
+
+  if (!paging_state().empty()) {
+    pos = encode_long_string(pos, paging_state().data(), paging_state().size());
+  }
+
+  if (serial_consistency() != 0) {
+    pos = encode_uint16(pos, serial_consistency());
+  }
+
+  return pos;
+}
+
+uint8_t ExecuteRequest::flags() const {
+  uint8_t flags = 0;
+  if (values_count() > 0) flags |= CASS_QUERY_FLAG_VALUES;
+  if (skip_metadata() && prepared_->has_valid_result_metadata()) {
+    flags |= CASS_QUERY_FLAG_SKIP_METADATA;
+  }
+  if (page_size() >= 0) flags |= CASS_QUERY_FLAG_PAGE_SIZE;
+  if (!paging_state().empty()) flags |= CASS_QUERY_FLAG_PAGING_STATE;
+  if (serial_consistency() != 0) flags |= CASS_QUERY_FLAG_SERIAL_CONSISTENCY;
+  return flags;
+}
+
+bool ExecuteRequest::can_reuse_frame() const {
+  // The frame can't skip the result metadata after it becomes stale
+  return !skip_metadata() || prepared_->has_valid_result_metadata();
+}
+
+bool ExecuteRequest::get_template(int version, Buffer* prefix, Buffer* suffix) const {
+  // The paging state is different for every page so it's not cached
+  if (!paging_state().empty()) {
+    return false;
+  }
+
+  if (is_template_busy_.exchange(true, boost::memory_order_acquire)) {
+    return false;
+  }
+
+  uint8_t flags = version == 1 ? 0 : this->flags();
+  if (template_.version != version ||
+      template_.flags != flags ||
+      template_.consistency != consistency() ||
+      template_.page_size != page_size() ||
+      template_.serial_consistency != serial_consistency()) {
+    encode_template(version, flags, &template_);
+  }
+
+  *prefix = template_.prefix;
+  *suffix = template_.suffix;
+
+  is_template_busy_.store(false, boost::memory_order_release);
+  return true;
+}
+
+void ExecuteRequest::encode_template(int version, uint8_t flags,
+                                     Template* temp) const {
+  const std::string& prepared_id = prepared_->id();
+
+  temp->version = version;
+  temp->flags = flags;
+  temp->consistency = consistency();
+  temp->page_size = page_size();
+  temp->serial_consistency = serial_consistency();
+
+  if (version == 1) {
+    // <id> [short bytes] + <n> [short]
+    temp->prefix = Buffer(sizeof(uint16_t) + prepared_id.size() +
+                          sizeof(uint16_t));
+    size_t pos = temp->prefix.encode_string(0, prepared_id.data(),
+                                            prepared_id.size());
+    temp->prefix.encode_uint16(pos, values_count());
+
+    // <consistency> [short]
+    temp->suffix = Buffer(sizeof(uint16_t));
+    temp->suffix.encode_uint16(0, consistency());
+    return;
+  }
+
+  // <id> [short bytes] + <consistency> [short] + <flags> [byte] + <n> [short]
+  size_t prefix_size = sizeof(uint16_t) + prepared_id.size() +
+                       sizeof(uint16_t) + sizeof(uint8_t);
+  if (values_count() > 0) {
+    prefix_size += sizeof(uint16_t);
+  }
+
+  temp->prefix = Buffer(prefix_size);
+  size_t pos = temp->prefix.encode_string(0, prepared_id.data(),
+                                          prepared_id.size());
+  pos = temp->prefix.encode_uint16(pos, consistency());
+  pos = temp->prefix.encode_byte(pos, flags);
+  if (values_count() > 0) {
+    temp->prefix.encode_uint16(pos, values_count());
+  }
+
+  // <page_size> [int] + <serial_consistency> [short]
+  size_t suffix_size = 0;
+  if (page_size() >= 0) {
+    suffix_size += sizeof(int32_t);
+  }
+  if (serial_consistency() != 0) {
+    suffix_size += sizeof(uint16_t);
+  }
+
+  temp->suffix = Buffer(suffix_size);
+  pos = 0;
+  if (page_size() >= 0) {
+    pos = temp->suffix.encode_int32(pos, page_size());
+  }
+  if (serial_consistency() != 0) {
+    temp->suffix.encode_uint16(pos, serial_consistency());
+  }
+}
+
 } // namespace cass
@@ -32,9 +32,11 @@ public:
   ExecuteRequest(const Prepared* prepared)
       : Statement(CQL_OPCODE_EXECUTE, CASS_BATCH_KIND_PREPARED,
                   prepared->result()->column_count())
-      , prepared_(prepared) {
+      , prepared_(prepared)
+      , is_template_busy_(false) {
       // If the prepared statment has result metadata then there is no
-      // need to get the metadata with this request too.
+      // need to get the metadata with this request too. This is checked
+      // again when the request is encoded in case the schema has changed.
       if (prepared->result()->result_metadata()) {
         set_skip_metadata(true);
       }
@@ -43,13 +45,45 @@ public:
   const std::string& query() const { return prepared_->id(); }
   const SharedRefPtr<const Prepared>& prepared() const { return prepared_; }
 
+  virtual bool can_reuse_frame() const;
+
+  // Executions encoded from the template keep their frame for retries
+  virtual bool keeps_frame() const { return paging_state().empty(); }
+
 private:
+  // The encoded fields before and after the values. Only the values change
+  // between most executions so these are encoded once and copied. They're
+  // encoded again if the protocol version or the statement's settings change.
+  struct Template {
+    Template()
+      : version(0) {}
+
+    int version;
+    uint8_t flags;
+    int16_t consistency;
+    int32_t page_size;
+    int16_t serial_consistency;
+    Buffer prefix;
+    Buffer suffix;
+  };
+
+  bool get_template(int version, Buffer* prefix, Buffer* suffix) const;
+  void encode_template(int version, uint8_t flags, Template* temp) const;
+
   int encode(int version, BufferVec* bufs) const;
   int encode_v1(BufferVec* bufs) const;
   int encode_v2(BufferVec* bufs) const;
 
+  int32_t body_size(int version) const;
+  char* encode_body(int version, char* output) const;
+  uint8_t flags() const;
+
 private:
   SharedRefPtr<const Prepared> prepared_;
+  // The same statement can be encoded by multiple IO workers at the same time.
+  // A worker that finds the template busy encodes the request without it.
+  mutable boost::atomic<bool> is_template_busy_;
+  mutable Template template_;
 };
 
 } // namespace cass
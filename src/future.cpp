@@ -49,6 +49,14 @@ cass_bool_t cass_future_wait_timed(CassFuture* future, cass_duration_t wait) {
   return static_cast<cass_bool_t>(future->wait_for(wait));
 }
 
+CassError cass_future_cancel(CassFuture* future) {
+  if (future->type() != cass::CASS_FUTURE_TYPE_RESPONSE) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  static_cast<cass::ResponseFuture*>(future->from())->cancel();
+  return CASS_OK;
+}
+
 CassSession* cass_future_get_session(CassFuture* future) {
   if (future->type() != cass::CASS_FUTURE_TYPE_SESSION_CONNECT) {
     return NULL;
@@ -90,6 +98,11 @@ const CassPrepared* cass_future_get_prepared(CassFuture* future) {
   if (response_future->is_error()) {
     return NULL;
   }
+  cass::SharedRefPtr<cass::Prepared> cached(response_future->release_prepared());
+  if (cached) {
+    cached->inc_ref();
+    return CassPrepared::to(cached.get());
+  }
   cass::ScopedPtr<cass::ResultResponse> result(
       static_cast<cass::ResultResponse*>(response_future->release_result()));
   if (result && result->kind() == CASS_RESULT_KIND_PREPARED) {
@@ -138,45 +151,54 @@ bool Future::set_callback(Future::Callback callback, void* data) {
   if (is_set_) {
     // Run the callback if the future is already set
     lock.unlock();
-    if (loop_ == NULL) {
+    if (loop_ == NULL || is_callback_inline_) {
       callback(CassFuture::to(this), data);
     } else if(callback_) {
-      run_callback_on_work_thread();
+      run_callback_async();
     }
   }
   return true;
 }
 
-void Future::internal_set(ScopedMutex& lock) {
+void Future::internal_set(ScopedMutex& lock, bool run_callback_inline) {
   is_set_ = true;
   uv_cond_broadcast(&cond_);
   if (callback_) {
-    if (loop_ == NULL) {
+    if (loop_ == NULL || is_callback_inline_ || run_callback_inline) {
       Callback callback = callback_;
       void* data = data_;
       lock.unlock();
       callback(CassFuture::to(this), data);
     } else {
-      run_callback_on_work_thread();
+      // The executor runs the callback on this thread once it's closed
+      lock.unlock();
+      run_callback_async();
     }
   }
 }
 
-void Future::run_callback_on_work_thread() {
+void Future::run_callback_async() {
   inc_ref(); // Keep the future alive for the callback
+  CallbackExecutor* executor = executor_.load();
+  if (executor != NULL) {
+    executor->submit(this);
+    return;
+  }
   work_.data = this;
   uv_queue_work(loop_, &work_, on_work, on_after_work);
 }
 
-void Future::on_work(uv_work_t* work) {
-  Future* future = static_cast<Future*>(work->data);
-
-  ScopedMutex lock(&future->mutex_);
-  Callback callback = future->callback_;
-  void* data = future->data_;
+void Future::run_callback() {
+  ScopedMutex lock(&mutex_);
+  Callback callback = callback_;
+  void* data = data_;
   lock.unlock();
 
-  callback(CassFuture::to(future), data);
+  callback(CassFuture::to(this), data);
+}
+
+void Future::on_work(uv_work_t* work) {
+  static_cast<Future*>(work->data)->run_callback();
 }
 
 void Future::on_after_work(uv_work_t* work, int status) {
@@ -17,6 +17,7 @@
 #ifndef __CASS_FUTURE_HPP_INCLUDED__
 #define __CASS_FUTURE_HPP_INCLUDED__
 
+#include "callback_executor.hpp"
 #include "cassandra.h"
 #include "host.hpp"
 #include "macros.hpp"
@@ -37,7 +38,9 @@ struct Error;
 enum FutureType {
   CASS_FUTURE_TYPE_SESSION_CONNECT,
   CASS_FUTURE_TYPE_SESSION_CLOSE,
-  CASS_FUTURE_TYPE_RESPONSE
+  CASS_FUTURE_TYPE_RESPONSE,
+  CASS_FUTURE_TYPE_SCAN,
+  CASS_FUTURE_TYPE_SCATTER
 };
 
 class Future : public RefCounted<Future> {
@@ -56,7 +59,9 @@ public:
   Future(FutureType type)
       : is_set_(false)
       , type_(type)
-      , loop_(NULL) {
+      , loop_(NULL)
+      , executor_(NULL)
+      , is_callback_inline_(false) {
     uv_mutex_init(&mutex_);
     uv_cond_init(&cond_);
   }
@@ -101,12 +106,35 @@ public:
     internal_set_error(code, message, lock);
   }
 
+  // Sets the error from a thread other than the IO thread that owns the
+  // future, the callback (if any) is run on the calling thread.
+  void set_error_from_caller(CassError code, const std::string& message) {
+    ScopedMutex lock(&mutex_);
+    internal_set_error(code, message, lock, true);
+  }
+
   void set_loop(uv_loop_t* loop) {
     loop_ = loop;
   }
 
+  // The callback runs on the executor's thread instead of a work thread
+  void set_callback_executor(CallbackExecutor* executor) {
+    executor_ = executor;
+  }
+
+  // The callback runs on the thread that sets the future, usually an IO
+  // thread, instead of a work thread. Only for short callbacks that don't
+  // block.
+  void set_callback_inline() {
+    ScopedMutex lock(&mutex_);
+    is_callback_inline_ = true;
+  }
+
   bool set_callback(Callback callback, void* data);
 
+  // Used by callback executors to run the callback of a set future
+  void run_callback();
+
 protected:
   void internal_wait(ScopedMutex& lock) {
     while (!is_set_) {
@@ -123,26 +151,30 @@ protected:
     return is_set_;
   }
 
-  void internal_set(ScopedMutex& lock);
+  void internal_set(ScopedMutex& lock, bool run_callback_inline = false);
 
-  void internal_set_error(CassError code, const std::string& message, ScopedMutex& lock) {
+  void internal_set_error(CassError code, const std::string& message, ScopedMutex& lock,
+                          bool run_callback_inline = false) {
+    if (is_set_) return; // The future was cancelled
     error_.reset(new Error(code, message));
-    internal_set(lock);
+    internal_set(lock, run_callback_inline);
   }
 
   uv_mutex_t mutex_;
+  bool is_set_;
 
 private:
-  void run_callback_on_work_thread();
+  void run_callback_async();
   static void on_work(uv_work_t* work);
   static void on_after_work(uv_work_t* work, int status);
 
 private:
-  bool is_set_;
   uv_cond_t cond_;
   FutureType type_;
   ScopedPtr<Error> error_;
   boost::atomic<uv_loop_t*> loop_;
+  boost::atomic<CallbackExecutor*> executor_;
+  bool is_callback_inline_;
   uv_work_t work_;
   Callback callback_;
   void* data_;
@@ -163,6 +195,10 @@ public:
 
   void set_result(Address address, T* result) {
     ScopedMutex lock(&mutex_);
+    if (is_set_) { // The future was cancelled
+      delete result;
+      return;
+    }
     address_ = address;
     result_.reset(result);
     internal_set(lock);
@@ -186,7 +222,7 @@ public:
     return address_;
   }
 
-private:
+protected:
   Address address_;
   ScopedPtr<T> result_;
 };
@@ -16,11 +16,16 @@
 
 #include "get_time.hpp"
 
+#include <uv.h>
+
 #if defined(WIN32) || defined(_WIN32)
 #include <Windows.h>
 #elif defined(__APPLE__) && defined(__MACH__)
+#include <errno.h>
 #include <sys/time.h>
+#include <time.h>
 #else
+#include <errno.h>
 #include <time.h>
 #endif
 
@@ -54,5 +59,28 @@ uint64_t get_time_since_epoch() {
   return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
+#endif
+
+uint64_t get_monotonic_time_ms() {
+  return uv_hrtime() / 1000000; // Nanoseconds to milliseconds
+}
+
+#if defined(WIN32) || defined(_WIN32)
+
+void sleep_for_microseconds(uint64_t us) {
+  Sleep(static_cast<DWORD>((us + 999) / 1000));
+}
+
+#else
+
+void sleep_for_microseconds(uint64_t us) {
+  struct timespec ts;
+  ts.tv_sec = us / 1000000;
+  ts.tv_nsec = (us % 1000000) * 1000;
+  while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {
+    // Interrupted, sleep for the remaining time
+  }
+}
+
 #endif
 }
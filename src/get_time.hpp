@@ -23,6 +23,12 @@ namespace cass {
 
 uint64_t get_time_since_epoch();
 
+// Milliseconds from an arbitrary point in the past. Unlike the time since
+// epoch it never jumps when the system clock is adjusted.
+uint64_t get_monotonic_time_ms();
+
+void sleep_for_microseconds(uint64_t us);
+
 }
 
 #endif
@@ -18,13 +18,37 @@
 
 #include "config.hpp"
 #include "connection.hpp"
+#include "execute_request.hpp"
 #include "logger.hpp"
+#include "prepared.hpp"
 #include "request.hpp"
+#include "response.hpp"
 #include "result_response.hpp"
+#include "statement.hpp"
 
 namespace cass {
 
-bool Handler::encode(int version, int flags) {
+bool Handler::encode(int version, int flags, BufferArena* arena) {
+  if (arena != NULL && writer_.has_frame(version, flags) &&
+      request()->can_reuse_frame()) {
+    writer_.set_frame_stream(stream_);
+    return true;
+  }
+
+  writer_.release_frame();
+
+  if (arena != NULL) {
+    int32_t frame_size = request()->frame_size(version);
+    if (frame_size >= 0) {
+      request()->encode_frame(version, flags, stream_, frame_size,
+                              writer_.allocate_frame(arena, frame_size,
+                                                     request()->keeps_frame()));
+      return true;
+    } else if (frame_size == Request::ENCODE_ERROR_UNSUPPORTED_PROTOCOL) {
+      return false;
+    }
+  }
+
   return request()->encode(version, flags, stream_, &writer_.bufs());
 }
 
@@ -33,6 +57,41 @@ void Handler::write(uv_stream_t* stream, void* data,
   writer_.write(stream, data, cb);
 }
 
+void Handler::maybe_stream_rows(ResponseMessage* response) {
+  if (!response->is_header_received() ||
+      response->is_body_discarded() ||
+      response->opcode() != CQL_OPCODE_RESULT) {
+    return;
+  }
+
+  if (state_ == REQUEST_STATE_TIMEOUT || is_cancelled()) {
+    if (response->is_streaming_rows()) {
+      response->discard_body();
+    }
+    return;
+  }
+
+  if (response->is_streaming_rows() ||
+      (request()->opcode() != CQL_OPCODE_QUERY &&
+       request()->opcode() != CQL_OPCODE_EXECUTE)) {
+    return;
+  }
+
+  const Statement* statement = static_cast<const Statement*>(request());
+  if (statement->row_callback() == NULL) {
+    return;
+  }
+
+  Metadata* metadata = NULL;
+  if (request()->opcode() == CQL_OPCODE_EXECUTE) {
+    const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request());
+    metadata = execute->prepared()->result()->result_metadata().get();
+  }
+
+  response->stream_rows(metadata, statement->row_callback(),
+                        statement->row_callback_data());
+}
+
 void Handler::set_state(Handler::State next_state) {
   switch (state_) {
     case REQUEST_STATE_NEW:
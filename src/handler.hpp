@@ -18,11 +18,13 @@
 #define __CASS_HANDLER_HPP_INCLUDED__
 
 #include "buffer.hpp"
+#include "buffer_arena.hpp"
 #include "cassandra.h"
 #include "common.hpp"
 #include "list.hpp"
 #include "scoped_ptr.hpp"
 
+#include <algorithm>
 #include <string>
 #include <uv.h>
 
@@ -90,23 +92,67 @@ public:
   RequestWriter()
       : data_(NULL)
       , cb_(NULL)
-      , status_(WRITING) {
+      , status_(WRITING)
+      , arena_(NULL)
+      , frame_(NULL)
+      , frame_size_(0)
+      , keep_frame_(false) {
     req_.data = this;
   }
 
+  ~RequestWriter() {
+    release_frame();
+  }
+
   enum Status { WRITING, FAILED, SUCCESS };
 
   Status status() { return status_; }
   void* data() { return data_; }
   BufferVec& bufs() { return bufs_; }
 
+  // A frame encoded into a single buffer is written instead of the buffer
+  // vector. It's returned to the arena as soon as the write completes
+  // unless it's kept so a retry can send it again with a new stream, in
+  // which case it's returned when the handler is done.
+  char* allocate_frame(BufferArena* arena, int32_t size, bool keep_frame) {
+    release_frame();
+    bufs_.clear();
+    arena_ = arena;
+    frame_ = arena->allocate(size);
+    frame_size_ = size;
+    keep_frame_ = keep_frame;
+    return frame_;
+  }
+
+  bool has_frame(int version, int flags) const {
+    return frame_ != NULL && frame_[0] == version && frame_[1] == flags;
+  }
+
+  void set_frame_stream(int8_t stream) {
+    assert(frame_ != NULL);
+    frame_[2] = stream;
+  }
+
+  void release_frame() {
+    if (frame_ != NULL) {
+      arena_->release(frame_, frame_size_);
+      frame_ = NULL;
+    }
+  }
+
   void write(uv_stream_t* stream, void* data, Callback cb) {
+    if (frame_ != NULL) {
+      write_frame(stream, data, cb);
+      return;
+    }
+
     size_t bufs_size = bufs_.size();
     ScopedPtr<uv_buf_t[]> uv_bufs(new uv_buf_t[bufs_size]);
 
     for (size_t i = 0; i < bufs_size; ++i) {
       Buffer& buf = bufs_[i];
-      uv_bufs[i] = uv_buf_init(const_cast<char*>(buf.data()), buf.size());
+      uv_bufs[i] = uv_buf_init(const_cast<char*>(buf.encoded_data()),
+                               buf.encoded_size());
     }
 
     data_ = data;
@@ -120,8 +166,26 @@ public:
   }
 
 private:
+  void write_frame(uv_stream_t* stream, void* data, Callback cb) {
+    uv_buf_t buf = uv_buf_init(frame_, frame_size_);
+
+    data_ = data;
+    cb_ = cb;
+
+    int rc = uv_write(&req_, stream, &buf, 1, on_write);
+    if (rc != 0) {
+      if (!keep_frame_) release_frame();
+      status_ = FAILED;
+      cb_(this);
+    }
+  }
+
   static void on_write(uv_write_t* req, int status) {
     RequestWriter* writer = static_cast<RequestWriter*>(req->data);
+    if (!writer->keep_frame_) {
+      writer->release_frame(); // The arena only caches a few blocks
+    }
+    writer->bufs_.clear(); // Release referenced application memory promptly
     if (status != 0) {
       writer->status_ = FAILED;
     } else {
@@ -136,6 +200,10 @@ private:
   void* data_;
   Callback cb_;
   Status status_;
+  BufferArena* arena_;
+  char* frame_;
+  int32_t frame_size_;
+  bool keep_frame_;
 };
 
 class Handler : public RefCounted<Handler>, public List<Handler>::Node {
@@ -151,15 +219,26 @@ public:
 
   Handler()
     : stream_(-1)
-    , state_(REQUEST_STATE_NEW) {}
+    , state_(REQUEST_STATE_NEW)
+    , deadline_(0) {}
 
   virtual ~Handler() {}
 
   virtual const Request* request() const = 0;
 
-  bool encode(int version, int flags);
+  // Cancelled requests are not written and their responses are discarded
+  virtual bool is_cancelled() const { return false; }
+
+  // Requests are encoded into a single buffer from the arena when they
+  // support it, otherwise (or without an arena) into a buffer vector.
+  bool encode(int version, int flags, BufferArena* arena = NULL);
   void write(uv_stream_t* stream, void* data, RequestWriter::Callback cb);
 
+  // Streams the rows of the response to the request's row callback once
+  // its header is received. Streaming stops as soon as the request has
+  // timed out or was cancelled because the callback's data may be gone.
+  void maybe_stream_rows(ResponseMessage* response);
+
   virtual void on_set(ResponseMessage* response) = 0;
   virtual void on_error(CassError code, const std::string& message) = 0;
   virtual void on_timeout() = 0;
@@ -174,6 +253,28 @@ public:
 
   void set_state(State next_state);
 
+  // The absolute time (milliseconds, from get_monotonic_time_ms()) after
+  // which the request is no longer useful. A value of zero means there is no deadline and
+  // the connection's request timeout is used.
+  uint64_t deadline() const { return deadline_; }
+
+  void set_deadline(uint64_t deadline) { deadline_ = deadline; }
+
+  bool is_past_deadline(uint64_t now) const {
+    return deadline_ != 0 && now >= deadline_;
+  }
+
+  uint64_t remaining_time(uint64_t now, uint64_t default_timeout) const {
+    if (deadline_ == 0) return default_timeout;
+    return now < deadline_ ? deadline_ - now : 0;
+  }
+
+  // A wait bounded by "max_wait", shortened to the time left before the
+  // deadline.
+  uint64_t wait_time(uint64_t now, uint64_t max_wait) const {
+    return std::min(max_wait, remaining_time(now, max_wait));
+  }
+
   void start_timer(uv_loop_t* loop, uint64_t timeout, void* data,
                    RequestTimer::Callback cb) {
     timer_.start(loop, timeout, data, cb);
@@ -188,6 +289,7 @@ private:
   RequestWriter writer_;
   int8_t stream_;
   State state_;
+  uint64_t deadline_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Handler);
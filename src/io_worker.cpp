@@ -17,6 +17,7 @@
 #include "io_worker.hpp"
 
 #include "config.hpp"
+#include "get_time.hpp"
 #include "logger.hpp"
 #include "request_handler.hpp"
 #include "session.hpp"
@@ -32,13 +33,16 @@ IOWorker::IOWorker(Session* session)
     , logger_(session->logger())
     , config_(session->config())
     , is_closing_(false)
+    , is_closed_(false)
     , pending_request_count_(0)
     , request_queue_(config_.queue_size_io()) {
   uv_mutex_init(&keyspace_mutex_);
+  uv_mutex_init(&concurrency_limits_mutex_);
 }
 
 IOWorker::~IOWorker() {
   uv_mutex_destroy(&keyspace_mutex_);
+  uv_mutex_destroy(&concurrency_limits_mutex_);
 }
 
 int IOWorker::init() {
@@ -46,6 +50,10 @@ int IOWorker::init() {
   if (rc != 0) return rc;
   rc = request_queue_.init(loop(), this, &IOWorker::on_execute);
   if (rc != 0) return rc;
+  if (config_.callback_mode() == CASS_CALLBACK_MODE_EXECUTOR) {
+    callback_executor_.reset(new CallbackExecutor());
+    rc = callback_executor_->init();
+  }
   return rc;
 }
 
@@ -81,6 +89,19 @@ bool IOWorker::is_host_up(const Address& address) const {
   return it != pools_.end() && it->second->is_ready();
 }
 
+unsigned IOWorker::concurrency_limit(const Address& address) {
+  // Called from application threads, pools publish their limit when it
+  // changes.
+  ScopedMutex lock(&concurrency_limits_mutex_);
+  ConcurrencyLimitMap::const_iterator it = concurrency_limits_.find(address);
+  return it != concurrency_limits_.end() ? it->second : 0;
+}
+
+void IOWorker::set_concurrency_limit(const Address& address, unsigned limit) {
+  ScopedMutex lock(&concurrency_limits_mutex_);
+  concurrency_limits_[address] = limit;
+}
+
 bool IOWorker::add_pool_async(const Address& address, bool is_initial_connection) {
   IOWorkerEvent event;
   event.type = IOWorkerEvent::ADD_POOL;
@@ -123,6 +144,19 @@ bool IOWorker::execute(RequestHandler* request_handler) {
 }
 
 void IOWorker::retry(RequestHandler* request_handler, RetryType retry_type) {
+  if (request_handler->is_cancelled()) {
+    request_handler->on_error(CASS_ERROR_LIB_REQUEST_CANCELLED,
+                              "Request cancelled");
+    return;
+  }
+
+  // The deadline is set when the request is submitted so the time spent
+  // in queues and previous attempts counts against it.
+  if (request_handler->is_past_deadline(get_monotonic_time_ms())) {
+    request_handler->on_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                              "Request timed out before it could be sent");
+    return;
+  }
 
   if (retry_type == RETRY_WITH_NEXT_HOST) {
     request_handler->next_host();
@@ -130,6 +164,15 @@ void IOWorker::retry(RequestHandler* request_handler, RetryType retry_type) {
 
   Address address;
   if (!request_handler->get_current_host_address(&address)) {
+    // Every host was either down or at its concurrency limit. Wait for a
+    // connection on the first host that was skipped for being at its limit.
+    if (request_handler->take_overflow_address(&address)) {
+      PoolMap::iterator it = pools_.find(address);
+      if (it != pools_.end() &&
+          it->second->wait_for_connection(request_handler)) {
+        return;
+      }
+    }
     request_handler->on_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
                               "No hosts available");
     return;
@@ -138,6 +181,11 @@ void IOWorker::retry(RequestHandler* request_handler, RetryType retry_type) {
   PoolMap::iterator it = pools_.find(address);
   if (it != pools_.end()) {
     const SharedRefPtr<Pool>& pool = it->second;
+    if (pool->is_at_concurrency_limit()) {
+      request_handler->set_overflow_address(address);
+      retry(request_handler, RETRY_WITH_NEXT_HOST);
+      return;
+    }
     Connection* connection = pool->borrow_connection();
     if (connection != NULL) {
       if (!pool->execute(connection, request_handler)) {
@@ -174,6 +222,11 @@ void IOWorker::notify_pool_closed(Pool* pool) {
   logger_->info("IOWorker: Pool for host %s closed",
                 address.to_string().c_str());
 
+  {
+    ScopedMutex lock(&concurrency_limits_mutex_);
+    concurrency_limits_.erase(address);
+  }
+
   // All non-shared pointers to this pool are invalid after this call
   // and it must be done before maybe_notify_closed().
   pools_.erase(address);
@@ -185,18 +238,46 @@ void IOWorker::notify_pool_closed(Pool* pool) {
   }
 }
 
+PreparedRegistry* IOWorker::prepared_registry() {
+  return session_->prepared_registry();
+}
+
+void IOWorker::on_prepared(const Address& address,
+                           const std::string& keyspace,
+                           const std::string& query,
+                           const std::string& prepared_id) {
+  if (!session_->prepared_registry()->add(prepared_id, keyspace, query)) {
+    return; // Already prepared by this session
+  }
+
+  if (!config_.prepare_on_all_hosts()) {
+    return;
+  }
+
+  // A single IO worker is enough because statements are prepared per host
+  for (PoolMap::iterator it = pools_.begin(), end = pools_.end();
+       it != end; ++it) {
+    if (it->first != address) {
+      it->second->prepare(keyspace, query);
+    }
+  }
+}
+
 void IOWorker::maybe_close() {
   if (is_closing_ && pending_request_count_ <= 0) {
-    for (PoolMap::iterator it = pools_.begin(), end = pools_.end(); it != end;
-         ++it) {
-      it->second->close();
+    for (PoolMap::iterator it = pools_.begin(); it != pools_.end();) {
+      // A pool without connections closes right away and removes itself
+      SharedRefPtr<Pool> pool((it++)->second);
+      pool->close();
     }
     maybe_notify_closed();
   }
 }
 
 void IOWorker::maybe_notify_closed() {
-  if (pools_.empty()) {
+  // Requests failed while closing the handles can get here again
+  if (pools_.empty() && !is_closed_) {
+    is_closed_ = true;
     session_->notify_closed_async();
     close_handles();
   }
@@ -209,6 +290,18 @@ void IOWorker::close_handles() {
        end = pending_reconnects_.end(); it != end; ++it) {
     it->second->stop_timer();
   }
+
+  // Requests delayed by a rate limiter are failed instead of being sent
+  // after the session has closed
+  TimerSet delay_timers;
+  delay_timers.swap(delay_timers_);
+  for (TimerSet::iterator it = delay_timers.begin(),
+       end = delay_timers.end(); it != end; ++it) {
+    RequestHandler* request_handler = static_cast<RequestHandler*>((*it)->data());
+    Timer::stop(*it);
+    request_handler->on_error(CASS_ERROR_LIB_REQUEST_CANCELLED,
+                              "The session closed before the request was sent");
+  }
   logger_->debug("IO worker active handles %d", loop()->active_handles);
 }
 
@@ -265,7 +358,16 @@ void IOWorker::on_execute(uv_async_t* async, int status) {
     if (request_handler != NULL) {
       io_worker->pending_request_count_++;
       request_handler->set_io_worker(io_worker);
-      request_handler->retry(RETRY_WITH_CURRENT_HOST);
+      uint64_t now = uv_hrtime() / 1000;
+      if (request_handler->dispatch_time() > now) {
+        // Round up so the request is never sent early
+        uint64_t delay_ms = (request_handler->dispatch_time() - now + 999) / 1000;
+        io_worker->delay_timers_.insert(
+              Timer::start(io_worker->loop(), delay_ms, request_handler,
+                           boost::bind(&IOWorker::on_delayed_request, io_worker, _1)));
+      } else {
+        request_handler->retry(RETRY_WITH_CURRENT_HOST);
+      }
     } else {
       io_worker->is_closing_ = true;
     }
@@ -273,6 +375,12 @@ void IOWorker::on_execute(uv_async_t* async, int status) {
   io_worker->maybe_close();
 }
 
+void IOWorker::on_delayed_request(Timer* timer) {
+  delay_timers_.erase(timer);
+  RequestHandler* request_handler = static_cast<RequestHandler*>(timer->data());
+  request_handler->retry(RETRY_WITH_CURRENT_HOST);
+}
+
 void IOWorker::PendingReconnect::stop_timer() {
   if (timer != NULL) {
     Timer::stop(timer);
@@ -19,17 +19,22 @@
 
 #include "address.hpp"
 #include "async_queue.hpp"
+#include "buffer_arena.hpp"
+#include "callback_executor.hpp"
 #include "constants.hpp"
 #include "event_thread.hpp"
 #include "list.hpp"
+#include "metadata_cache.hpp"
 #include "pool.hpp"
 #include "ref_counted.hpp"
+#include "scoped_ptr.hpp"
 #include "spsc_queue.hpp"
 
 #include "third_party/boost/boost/atomic.hpp"
 
 #include <map>
 #include <list>
+#include <set>
 #include <string>
 #include <uv.h>
 
@@ -40,6 +45,7 @@ class Config;
 class SSLContext;
 class RequestHandler;
 class Logger;
+class PreparedRegistry;
 class Timer;
 
 struct IOWorkerEvent {
@@ -77,6 +83,16 @@ public:
 
   bool is_host_up(const Address& address) const;
 
+  BufferArena* buffer_arena() { return &buffer_arena_; }
+
+  MetadataCache* metadata_cache() { return &metadata_cache_; }
+
+  // NULL unless callbacks run on an executor
+  CallbackExecutor* callback_executor() { return callback_executor_.get(); }
+
+  unsigned concurrency_limit(const Address& address);
+  void set_concurrency_limit(const Address& address, unsigned limit);
+
   bool add_pool_async(const Address& address, bool is_initial_connection);
   bool remove_pool_async(const Address& address);
   bool schedule_reconnect_async(const Address& address, uint64_t wait);
@@ -90,6 +106,12 @@ public:
   void notify_pool_ready(Pool* pool);
   void notify_pool_closed(Pool* pool);
 
+  PreparedRegistry* prepared_registry();
+  void on_prepared(const Address& address,
+                   const std::string& keyspace,
+                   const std::string& query,
+                   const std::string& prepared_id);
+
 private:
   void add_pool(const Address& address, bool is_initial_connection);
   void maybe_close();
@@ -97,6 +119,7 @@ private:
   void close_handles();
 
   void on_pending_pool_reconnect(Timer* timer);
+  void on_delayed_request(Timer* timer);
 
   virtual void on_event(const IOWorkerEvent& event);
 
@@ -117,6 +140,8 @@ private:
   };
 
   typedef std::map<Address, SharedRefPtr<PendingReconnect> > PendingReconnectMap;
+  typedef std::set<Timer*> TimerSet;
+  typedef std::map<Address, unsigned> ConcurrencyLimitMap;
 
 private:
   Session* session_;
@@ -125,13 +150,20 @@ private:
   boost::atomic<int> protocol_version_;
   std::string keyspace_;
   uv_mutex_t keyspace_mutex_;
+  ConcurrencyLimitMap concurrency_limits_;
+  uv_mutex_t concurrency_limits_mutex_;
 
   PoolMap pools_;
   bool is_closing_;
+  bool is_closed_;
   int pending_request_count_;
   PendingReconnectMap pending_reconnects_;
+  TimerSet delay_timers_; // Requests waiting for their dispatch time
 
   AsyncQueue<SPSCQueue<RequestHandler*> > request_queue_;
+  BufferArena buffer_arena_;
+  MetadataCache metadata_cache_;
+  ScopedPtr<CallbackExecutor> callback_executor_;
 };
 
 } // namespace cass
@@ -20,6 +20,7 @@
 #include "map_iterator.hpp"
 #include "result_iterator.hpp"
 #include "row_iterator.hpp"
+#include "scatter_gather.hpp"
 #include "types.hpp"
 
 extern "C" {
@@ -55,6 +56,11 @@ cass_bool_t cass_iterator_next(CassIterator* iterator) {
 }
 
 const CassRow* cass_iterator_get_row(CassIterator* iterator) {
+  if (iterator->type() == cass::CASS_ITERATOR_TYPE_MULTIPLE_RESULT) {
+    return CassRow::to(
+          static_cast<cass::MultipleResultIterator*>(
+                         iterator->from())->row());
+  }
   if (iterator->type() != cass::CASS_ITERATOR_TYPE_RESULT) {
     return NULL;
   }
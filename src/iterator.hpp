@@ -24,6 +24,7 @@ enum IteratorType {
   CASS_ITERATOR_TYPE_ROW,
   CASS_ITERATOR_COLLECTION,
   CASS_ITERATOR_MAP,
+  CASS_ITERATOR_TYPE_MULTIPLE_RESULT,
   CASS_ITERATOR_TYPE_UNKNOWN
 };
 
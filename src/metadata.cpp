@@ -22,6 +22,7 @@
 #include "third_party/boost/boost/algorithm/string.hpp"
 
 #include <iterator>
+#include <string.h>
 
 // This can be decreased to reduce hash collisions, but it will require
 // additional memory.
@@ -54,7 +55,19 @@ private:
 
 namespace cass {
 
-Metadata::Metadata(size_t column_count) {
+Metadata::Metadata(size_t column_count)
+  : specs_size_(0) {
+  init(column_count);
+}
+
+Metadata::Metadata(size_t column_count, const char* specs, size_t specs_size)
+  : specs_(new char[specs_size])
+  , specs_size_(specs_size) {
+  memcpy(specs_.get(), specs, specs_size);
+  init(column_count);
+}
+
+void Metadata::init(size_t column_count) {
   defs_.reserve(column_count);
 
   size_t index_size = next_pow_2(static_cast<size_t>(column_count / LOAD_FACTOR) + 1);
@@ -109,6 +122,19 @@ size_t Metadata::get(boost::string_ref name,
   return result->size();
 }
 
+bool Metadata::get_handle(boost::string_ref name,
+                          CassColumnHandle* handle) const {
+  IndexVec indices;
+  if (get(name, &indices) == 0) {
+    return false;
+  }
+  handle->column = &defs_[indices[0]];
+  handle->index = indices[0];
+  handle->is_case_sensitive = static_cast<cass_bool_t>(
+        name.size() > 1 && name.front() == '"' && name.back() == '"');
+  return true;
+}
+
 void Metadata::insert(ColumnDefinition& def) {
   defs_.push_back(def);
 
@@ -21,6 +21,7 @@
 #include "list.hpp"
 #include "fixed_vector.hpp"
 #include "ref_counted.hpp"
+#include "scoped_ptr.hpp"
 
 #include "third_party/boost/boost/cstdint.hpp"
 #include "third_party/boost/boost/utility/string_ref.hpp"
@@ -84,20 +85,39 @@ public:
 
   Metadata(size_t column_count);
 
+  // The column definitions are decoded from a copy of the raw column specs
+  // so the metadata can outlive the result it was decoded from.
+  Metadata(size_t column_count, const char* specs, size_t specs_size);
+
+  char* specs() const { return specs_.get(); }
+  size_t specs_size() const { return specs_size_; }
+
   const ColumnDefinition& get(size_t index) const { return defs_[index]; }
 
   size_t get(boost::string_ref name, IndexVec* result) const;
 
+  // Handles reference the first column with the name, the rest are found
+  // through the column's "next" pointer.
+  bool get_handle(boost::string_ref name, CassColumnHandle* handle) const;
+
+  bool is_valid_handle(const CassColumnHandle& handle) const {
+    return handle.index < defs_.size() && &defs_[handle.index] == handle.column;
+  }
+
   size_t column_count() const { return defs_.size(); }
 
   void insert(ColumnDefinition& meta);
 
 private:
+  void init(size_t column_count);
+
   static const size_t FIXED_COLUMN_META_SIZE = 16;
 
   FixedVector<ColumnDefinition, FIXED_COLUMN_META_SIZE> defs_;
   FixedVector<ColumnDefinition*, 2 * FIXED_COLUMN_META_SIZE> index_;
   size_t index_mask_;
+  ScopedPtr<char[]> specs_;
+  size_t specs_size_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Metadata);
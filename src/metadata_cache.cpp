@@ -0,0 +1,65 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "metadata_cache.hpp"
+
+#include "third_party/boost/boost/functional/hash.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+// Must be a power of two. A new entry replaces the entry in its slot.
+#define NUM_ENTRIES 64
+
+namespace cass {
+
+MetadataCache::MetadataCache()
+  : entries_(NUM_ENTRIES) {}
+
+Metadata* MetadataCache::get(bool global_table_spec, int32_t column_count,
+                             const char* specs, size_t specs_size) const {
+  size_t h = hash(global_table_spec, column_count, specs, specs_size);
+  const Entry& entry = entries_[h & (NUM_ENTRIES - 1)];
+  if (entry.metadata &&
+      entry.hash == h &&
+      entry.global_table_spec == global_table_spec &&
+      entry.metadata->column_count() == static_cast<size_t>(column_count) &&
+      entry.metadata->specs_size() == specs_size &&
+      memcmp(entry.metadata->specs(), specs, specs_size) == 0) {
+    return entry.metadata.get();
+  }
+  return NULL;
+}
+
+void MetadataCache::put(bool global_table_spec, Metadata* metadata) {
+  assert(metadata->specs() != NULL);
+  size_t h = hash(global_table_spec, metadata->column_count(),
+                  metadata->specs(), metadata->specs_size());
+  Entry& entry = entries_[h & (NUM_ENTRIES - 1)];
+  entry.hash = h;
+  entry.global_table_spec = global_table_spec;
+  entry.metadata.reset(metadata);
+}
+
+size_t MetadataCache::hash(bool global_table_spec, int32_t column_count,
+                           const char* specs, size_t specs_size) {
+  size_t h = boost::hash_range(specs, specs + specs_size);
+  boost::hash_combine(h, column_count);
+  boost::hash_combine(h, global_table_spec);
+  return h;
+}
+
+} // namespace cass
@@ -0,0 +1,70 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_METADATA_CACHE_HPP_INCLUDED__
+#define __CASS_METADATA_CACHE_HPP_INCLUDED__
+
+#include "macros.hpp"
+#include "metadata.hpp"
+#include "ref_counted.hpp"
+
+#include <stddef.h>
+#include <vector>
+
+namespace cass {
+
+// A cache of decoded result metadata keyed by the raw column specs. Results
+// of the same query have identical specs so they share a single Metadata
+// instead of decoding and indexing the column names of every result. A
+// schema change changes the specs so stale metadata is never returned.
+// Each IO worker has its own cache and it's only used from the IO worker's
+// thread so it's not locked.
+class MetadataCache {
+public:
+  MetadataCache();
+
+  // Returns NULL if there's no metadata for the specs
+  Metadata* get(bool global_table_spec, int32_t column_count,
+                const char* specs, size_t specs_size) const;
+
+  // The metadata must own a copy of its specs
+  void put(bool global_table_spec, Metadata* metadata);
+
+private:
+  struct Entry {
+    Entry()
+      : hash(0)
+      , global_table_spec(false) {}
+
+    size_t hash;
+    bool global_table_spec;
+    SharedRefPtr<Metadata> metadata;
+  };
+
+  typedef std::vector<Entry> EntryVec;
+
+  static size_t hash(bool global_table_spec, int32_t column_count,
+                     const char* specs, size_t specs_size);
+
+  EntryVec entries_; // Direct mapped by hash
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(MetadataCache);
+};
+
+} // namespace cass
+
+#endif
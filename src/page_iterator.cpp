@@ -0,0 +1,196 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "page_iterator.hpp"
+
+#include "future.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "scoped_mutex.hpp"
+#include "types.hpp"
+
+#include "third_party/boost/boost/bind.hpp"
+
+extern "C" {
+
+CassPageIterator* cass_session_execute_paged(CassSession* session,
+                                             CassStatement* statement,
+                                             cass_size_t prefetch_count) {
+  cass::PageIterator* iterator =
+      new cass::PageIterator(session, statement, prefetch_count);
+  iterator->inc_ref(); // External reference
+  iterator->start();
+  return CassPageIterator::to(iterator);
+}
+
+void cass_page_iterator_free(CassPageIterator* iterator) {
+  iterator->close();
+  iterator->dec_ref();
+}
+
+const CassResult* cass_page_iterator_next(CassPageIterator* iterator) {
+  return CassResult::to(iterator->next_page());
+}
+
+CassError cass_page_iterator_error_code(CassPageIterator* iterator) {
+  return iterator->error_code();
+}
+
+CassString cass_page_iterator_error_message(CassPageIterator* iterator) {
+  const std::string& message = iterator->error_message();
+  CassString str;
+  str.data = message.data();
+  str.length = message.size();
+  return str;
+}
+
+} // extern "C"
+
+namespace cass {
+
+PageIterator::PageIterator(RequestExecutor* executor, Statement* statement,
+                           size_t prefetch_count)
+  : executor_(executor)
+  , statement_(statement)
+  , prefetch_count_(prefetch_count > 0 ? prefetch_count : 1)
+  , is_fetching_(false)
+  , has_more_pages_(true)
+  , is_closed_(false)
+  , error_code_(CASS_OK) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+PageIterator::~PageIterator() {
+  for (PageQueue::iterator it = pages_.begin(),
+       end = pages_.end(); it != end; ++it) {
+    delete *it;
+  }
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+void PageIterator::start() {
+  {
+    ScopedMutex lock(&mutex_);
+    // A frozen body would ignore the paging state
+    statement_->unfreeze();
+    statement_->set_paging_state(std::string());
+    is_fetching_ = true;
+  }
+  fetch();
+}
+
+ResultResponse* PageIterator::next_page() {
+  ResultResponse* result = NULL;
+  bool fetch_next = false;
+  {
+    ScopedMutex lock(&mutex_);
+    while (pages_.empty() && is_fetching_) {
+      uv_cond_wait(&cond_, lock.get());
+    }
+    if (!pages_.empty()) {
+      result = pages_.front();
+      pages_.pop_front();
+    }
+    fetch_next = should_fetch();
+    if (fetch_next) is_fetching_ = true;
+  }
+  if (fetch_next) {
+    fetch();
+  }
+  return result;
+}
+
+CassError PageIterator::error_code() const {
+  ScopedMutex lock(&mutex_);
+  return error_code_;
+}
+
+const std::string& PageIterator::error_message() const {
+  ScopedMutex lock(&mutex_);
+  return error_message_;
+}
+
+void PageIterator::close() {
+  ScopedMutex lock(&mutex_);
+  is_closed_ = true;
+}
+
+bool PageIterator::should_fetch() const {
+  return !is_fetching_ && !is_closed_ && has_more_pages_ &&
+      error_code_ == CASS_OK && pages_.size() < prefetch_count_;
+}
+
+void PageIterator::fetch() {
+  Future* future = NULL;
+  if (executor_->is_closing()) {
+    // The session can be gone by the time a request sent now would finish
+    future = new ResponseFuture();
+    future->inc_ref();
+    future->set_error(CASS_ERROR_LIB_REQUEST_CANCELLED,
+                      "The session is closing");
+  } else {
+    // The statement isn't used by another request while a page is fetched
+    future = executor_->execute_internal(statement_.get());
+  }
+  future->set_callback(boost::bind(&PageIterator::on_page,
+                                   SharedRefPtr<PageIterator>(this), _1),
+                       NULL);
+  future->dec_ref();
+}
+
+void PageIterator::on_page(const SharedRefPtr<PageIterator>& iterator,
+                           CassFuture* future) {
+  ResponseFuture* response_future = static_cast<ResponseFuture*>(future->from());
+
+  const Future::Error* error = response_future->get_error();
+  ResultResponse* result = NULL;
+  if (error == NULL) {
+    result = static_cast<ResultResponse*>(response_future->release_result());
+    result->decode_first_row();
+  }
+
+  bool fetch_next = false;
+  {
+    ScopedMutex lock(&iterator->mutex_);
+    iterator->is_fetching_ = false;
+
+    if (error != NULL) {
+      iterator->error_code_ = error->code;
+      iterator->error_message_ = error->message;
+    } else {
+      iterator->pages_.push_back(result);
+      iterator->has_more_pages_ = result->has_more_pages();
+      if (iterator->has_more_pages_) {
+        iterator->statement_->set_paging_state(result->paging_state());
+        iterator->statement_->update_page_size(result->rows_size(),
+                                               result->row_count());
+      }
+    }
+
+    fetch_next = iterator->should_fetch();
+    if (fetch_next) iterator->is_fetching_ = true;
+
+    uv_cond_broadcast(&iterator->cond_);
+  }
+
+  if (fetch_next) {
+    iterator->fetch();
+  }
+}
+
+} // namespace cass
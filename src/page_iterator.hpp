@@ -0,0 +1,88 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_PAGE_ITERATOR_HPP_INCLUDED__
+#define __CASS_PAGE_ITERATOR_HPP_INCLUDED__
+
+#include "cassandra.h"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "request_executor.hpp"
+#include "statement.hpp"
+
+#include <uv.h>
+
+#include <deque>
+#include <string>
+
+namespace cass {
+
+class ResultResponse;
+
+// Iterates over the pages of a statement's result. The next page is
+// requested as soon as the previous one arrives, so up to "prefetch_count"
+// pages are fetched before the application asks for them. Pages depend on
+// the paging state of the previous page so only one request is in-flight
+// at a time. No more pages are requested once the session starts closing.
+class PageIterator : public RefCounted<PageIterator> {
+public:
+  PageIterator(RequestExecutor* executor, Statement* statement,
+               size_t prefetch_count);
+  ~PageIterator();
+
+  void start();
+
+  // Waits for the next page. Returns NULL after the last page or if an
+  // error occurred.
+  ResultResponse* next_page();
+
+  CassError error_code() const;
+
+  // The message doesn't change after an error stops the iterator
+  const std::string& error_message() const;
+
+  // Stops fetching pages. In-flight pages are discarded when they arrive.
+  void close();
+
+private:
+  typedef std::deque<ResultResponse*> PageQueue;
+
+  static void on_page(const SharedRefPtr<PageIterator>& iterator,
+                      CassFuture* future);
+
+  bool should_fetch() const;
+  void fetch();
+
+private:
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  RequestExecutor* executor_;
+  SharedRefPtr<Statement> statement_;
+  size_t prefetch_count_;
+  PageQueue pages_;
+  bool is_fetching_;
+  bool has_more_pages_;
+  bool is_closed_;
+  CassError error_code_;
+  std::string error_message_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PageIterator);
+};
+
+} // namespace cass
+
+#endif
@@ -18,9 +18,12 @@
 
 #include "connection.hpp"
 #include "error_response.hpp"
+#include "get_time.hpp"
 #include "io_worker.hpp"
 #include "logger.hpp"
 #include "prepare_handler.hpp"
+#include "prepare_host_handler.hpp"
+#include "prepare_request.hpp"
 #include "session.hpp"
 #include "set_keyspace_handler.hpp"
 #include "request_handler.hpp"
@@ -45,7 +48,16 @@ Pool::Pool(IOWorker* io_worker, const Address& address,
     , state_(POOL_STATE_NEW)
     , is_initial_connection_(is_initial_connection)
     , is_defunct_(false)
-    , is_critical_failure_(false) {}
+    , is_critical_failure_(false)
+    , should_prepare_statements_(!is_initial_connection &&
+                                 config_.prepare_on_up_or_add_host())
+    , is_preparing_statements_(false) {
+  if (config_.is_adaptive_concurrency()) {
+    limiter_.reset(new ConcurrencyLimiter(config_.initial_concurrency_limit(),
+                                          config_.max_concurrency_limit()));
+    notify_concurrency_limit();
+  }
+}
 
 Pool::~Pool() {
   while (!pending_requests_.is_empty()) {
@@ -112,7 +124,10 @@ Connection* Pool::borrow_connection() {
 }
 
 void Pool::return_connection(Connection* connection) {
-  if (connection->is_ready() && !pending_requests_.is_empty()) {
+  std::vector<RequestHandler*> cancelled;
+  remove_cancelled_pending_requests(&cancelled);
+  if (connection->is_ready() && !pending_requests_.is_empty() &&
+      !is_at_concurrency_limit()) {
     RequestHandler* request_handler
         = static_cast<RequestHandler*>(pending_requests_.front());
     pending_requests_.remove(request_handler);
@@ -121,10 +136,25 @@ void Pool::return_connection(Connection* connection) {
       request_handler->retry(RETRY_WITH_NEXT_HOST);
     }
   }
+  finish_cancelled_requests(cancelled);
 }
 
 bool Pool::execute(Connection* connection, RequestHandler* request_handler) {
   request_handler->set_connection_and_pool(connection, this);
+  request_handler->set_start_time(uv_hrtime());
+  const Request* request = request_handler->request();
+  if (request->opcode() == CQL_OPCODE_PREPARE) {
+    // Prepared statements are cached by keyspace so a prepare must run in
+    // the keyspace it was cached under.
+    const std::string& keyspace
+        = static_cast<const PrepareRequest*>(request)->keyspace();
+    if (keyspace == connection->keyspace()) {
+      return connection->execute(request_handler);
+    } else if (!keyspace.empty()) {
+      return connection->execute(new SetKeyspaceHandler(
+          connection, keyspace, request_handler));
+    }
+  }
   if (io_worker_->is_current_keyspace(connection->keyspace())) {
     return connection->execute(request_handler);
   } else {
@@ -133,6 +163,47 @@ bool Pool::execute(Connection* connection, RequestHandler* request_handler) {
   }
 }
 
+bool Pool::is_at_concurrency_limit() const {
+  return limiter_ && limiter_->is_limited(in_flight_count());
+}
+
+void Pool::on_response_time(uint64_t rtt_us) {
+  if (limiter_ && limiter_->on_response(rtt_us, in_flight_count())) {
+    notify_concurrency_limit();
+  }
+}
+
+void Pool::on_request_timeout() {
+  if (limiter_ && limiter_->on_timeout()) {
+    notify_concurrency_limit();
+  }
+}
+
+void Pool::prepare(const std::string& keyspace, const std::string& query) {
+  if (state_ != POOL_STATE_READY || connections_.empty()) {
+    return;
+  }
+
+  Connection* connection = find_least_busy();
+  if (connection == NULL || connection->keyspace() != keyspace) {
+    // Requests will prepare the statement on this host if it's needed
+    return;
+  }
+
+  SharedRefPtr<PrepareHostHandler> handler(
+        new PrepareHostHandler(this, connection,
+                               PreparedRegistry::QueryVec(1, query)));
+  handler->prepare();
+}
+
+void Pool::add_prepare_handler(PrepareHostHandler* handler) {
+  prepare_handlers_.insert(handler);
+}
+
+void Pool::remove_prepare_handler(PrepareHostHandler* handler) {
+  prepare_handlers_.erase(handler);
+}
+
 void Pool::defunct() {
   is_defunct_ = true;
   close();
@@ -163,6 +234,11 @@ void Pool::spawn_connection() {
                        io_worker_->keyspace(),
                        io_worker_->protocol_version());
 
+    if (config_.single_buffer_encoding()) {
+      connection->set_buffer_arena(io_worker_->buffer_arena());
+    }
+    connection->set_metadata_cache(io_worker_->metadata_cache());
+
     logger_->info("Pool: Spawning new conneciton to host %s", address_.to_string(true).c_str());
     connection->set_ready_callback(
           boost::bind(&Pool::on_connection_ready, this, _1));
@@ -191,6 +267,27 @@ void Pool::maybe_spawn_connection() {
   spawn_connection();
 }
 
+void Pool::remove_cancelled_pending_requests(std::vector<RequestHandler*>* cancelled) {
+  List<Handler>::Iterator<Handler> it = pending_requests_.iterator();
+  while (it.has_next()) {
+    RequestHandler* request_handler = static_cast<RequestHandler*>(it.next());
+    if (request_handler->is_cancelled()) {
+      pending_requests_.remove(request_handler);
+      request_handler->stop_timer();
+      cancelled->push_back(request_handler);
+    }
+  }
+}
+
+// Finishing a request can close this pool so this must be the last thing
+// done before returning to the IO worker.
+void Pool::finish_cancelled_requests(const std::vector<RequestHandler*>& cancelled) {
+  for (std::vector<RequestHandler*>::const_iterator it = cancelled.begin(),
+       end = cancelled.end(); it != end; ++it) {
+    (*it)->on_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request cancelled");
+  }
+}
+
 Connection* Pool::find_least_busy() {
   ConnectionVec::iterator it = std::min_element(
       connections_.begin(), connections_.end(), least_busy_comp);
@@ -200,7 +297,20 @@ Connection* Pool::find_least_busy() {
   return NULL;
 }
 
-void Pool::on_connection_ready(Connection* connection) {
+size_t Pool::in_flight_count() const {
+  size_t count = 0;
+  for (ConnectionVec::const_iterator it = connections_.begin(),
+       end = connections_.end(); it != end; ++it) {
+    count += (*it)->pending_request_count();
+  }
+  return count;
+}
+
+void Pool::notify_concurrency_limit() {
+  io_worker_->set_concurrency_limit(address_, limiter_->limit());
+}
+
+void Pool::add_ready_connection(Connection* connection) {
   connections_pending_.erase(connection);
   maybe_notify_ready();
 
@@ -208,6 +318,61 @@ void Pool::on_connection_ready(Connection* connection) {
   return_connection(connection);
 }
 
+bool Pool::maybe_prepare_statements(Connection* connection) {
+  if (!should_prepare_statements_) {
+    return false;
+  }
+  should_prepare_statements_ = false; // Prepared statements are per host
+
+  PreparedRegistry::QueryVec queries;
+  io_worker_->prepared_registry()->get_queries(connection->keyspace(), &queries);
+  if (queries.empty()) {
+    return false;
+  }
+
+  logger_->info("Pool: Preparing %u statements on host %s",
+                static_cast<unsigned>(queries.size()),
+                address_.to_string().c_str());
+
+  is_preparing_statements_ = true;
+  SharedRefPtr<PrepareHostHandler> handler(
+        new PrepareHostHandler(this, connection, queries,
+                               boost::bind(&Pool::on_connection_prepared, this, _1)));
+  handler->prepare();
+  return true;
+}
+
+void Pool::on_connection_ready(Connection* connection) {
+  // Connections stay pending while statements are being prepared so the
+  // pool doesn't become ready and the host doesn't receive requests until
+  // they're done.
+  if (is_preparing_statements_ || maybe_prepare_statements(connection)) {
+    return;
+  }
+
+  add_ready_connection(connection);
+}
+
+void Pool::on_connection_prepared(PrepareHostHandler* handler) {
+  is_preparing_statements_ = false;
+
+  logger_->debug("Pool: Finished preparing statements on host %s",
+                 address_.to_string().c_str());
+
+  ConnectionVec ready;
+  for (ConnectionSet::iterator it = connections_pending_.begin(),
+       end = connections_pending_.end(); it != end; ++it) {
+    if ((*it)->is_ready()) {
+      ready.push_back(*it);
+    }
+  }
+
+  for (ConnectionVec::iterator it = ready.begin(),
+       end = ready.end(); it != end; ++it) {
+    add_ready_connection(*it);
+  }
+}
+
 void Pool::on_connection_closed(Connection* connection) {
   connections_pending_.erase(connection);
 
@@ -217,6 +382,19 @@ void Pool::on_connection_closed(Connection* connection) {
     connections_.erase(it);
   }
 
+  // Finishing a handler can release it and remove it from the set
+  std::vector<PrepareHostHandler*> prepare_handlers;
+  for (PrepareHandlerSet::iterator it = prepare_handlers_.begin(),
+       end = prepare_handlers_.end(); it != end; ++it) {
+    if ((*it)->connection() == connection) {
+      prepare_handlers.push_back(*it);
+    }
+  }
+  for (std::vector<PrepareHostHandler*>::iterator it = prepare_handlers.begin(),
+       end = prepare_handlers.end(); it != end; ++it) {
+    (*it)->on_connection_closed();
+  }
+
   if (connection->is_defunct()) {
     // If at least one connection has a critical failure then don't try to
     // reconnect automatically.
@@ -238,16 +416,28 @@ void Pool::on_pending_request_timeout(RequestTimer* timer) {
 }
 
 bool Pool::wait_for_connection(RequestHandler* request_handler) {
+  std::vector<RequestHandler*> cancelled;
+  if (pending_requests_.size() + 1 > config_.max_pending_requests()) {
+    remove_cancelled_pending_requests(&cancelled);
+  }
+
   if (pending_requests_.size() + 1 > config_.max_pending_requests()) {
     logger_->warn("Exceeded the max pending requests setting of %u on host %s",
                   config_.max_pending_requests(),
                   address_.to_string().c_str());
+    finish_cancelled_requests(cancelled);
     return false;
   }
 
-  request_handler->start_timer(loop_, config_.connect_timeout(), request_handler,
+  // Wait at most the connect timeout for this host, but never past the
+  // request's deadline.
+  uint64_t timeout =
+      request_handler->wait_time(get_monotonic_time_ms(),
+                                 config_.connect_timeout());
+  request_handler->start_timer(loop_, timeout, request_handler,
                                boost::bind(&Pool::on_pending_request_timeout, this, _1));
   pending_requests_.add_to_back(request_handler);
+  finish_cancelled_requests(cancelled);
   return true;
 }
 
@@ -18,6 +18,7 @@
 #define __CASS_POOL_HPP_INCLUDED__
 
 #include "cassandra.h"
+#include "concurrency_limiter.hpp"
 #include "ref_counted.hpp"
 #include "request.hpp"
 #include "request_handler.hpp"
@@ -27,12 +28,14 @@
 #include <functional>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace cass {
 
 class Connection;
 class IOWorker;
 class Logger;
+class PrepareHostHandler;
 class RequestHandler;
 class Config;
 
@@ -66,22 +69,43 @@ public:
 
   void return_connection(Connection* connection);
 
+  bool is_at_concurrency_limit() const;
+  void on_response_time(uint64_t rtt_us);
+  void on_request_timeout();
+
+  // Prepares a statement on this pool's host in the background
+  void prepare(const std::string& keyspace, const std::string& query);
+
+  // Handlers preparing statements on this pool's connections are told when
+  // their connection closes
+  void add_prepare_handler(PrepareHostHandler* handler);
+  void remove_prepare_handler(PrepareHostHandler* handler);
+
 private:
   void defunct();
   void maybe_notify_ready();
   void maybe_close();
   void spawn_connection();
   void maybe_spawn_connection();
+  void remove_cancelled_pending_requests(std::vector<RequestHandler*>* cancelled);
+  void finish_cancelled_requests(const std::vector<RequestHandler*>& cancelled);
+
+  void add_ready_connection(Connection* connection);
+  bool maybe_prepare_statements(Connection* connection);
 
   void on_connection_ready(Connection* connection);
+  void on_connection_prepared(PrepareHostHandler* handler);
   void on_connection_closed(Connection* connection);
   void on_pending_request_timeout(RequestTimer* data);
 
   Connection* find_least_busy();
+  size_t in_flight_count() const;
+  void notify_concurrency_limit();
 
 private:
   typedef std::set<Connection*> ConnectionSet;
   typedef std::vector<Connection*> ConnectionVec;
+  typedef std::set<PrepareHostHandler*> PrepareHandlerSet;
 
   IOWorker* io_worker_;
   Address address_;
@@ -92,10 +116,14 @@ private:
   PoolState state_;
   ConnectionVec connections_;
   ConnectionSet connections_pending_;
+  PrepareHandlerSet prepare_handlers_;
   List<Handler> pending_requests_;
+  ScopedPtr<ConcurrencyLimiter> limiter_;
   bool is_initial_connection_;
   bool is_defunct_;
   bool is_critical_failure_;
+  bool should_prepare_statements_;
+  bool is_preparing_statements_;
 };
 
 } // namespace cass
@@ -30,12 +30,18 @@ class Request;
 class PrepareHandler : public Handler {
 public:
   PrepareHandler(RequestHandler* request_handler)
-      : request_handler_(request_handler) {}
+      : request_handler_(request_handler) {
+    set_deadline(request_handler->deadline());
+  }
 
   bool init(const std::string& prepared_id);
 
   virtual const Request* request() const { return request_.get(); }
 
+  virtual bool is_cancelled() const {
+    return request_handler_->is_cancelled();
+  }
+
   virtual void on_set(ResponseMessage* response);
 
   virtual void on_error(CassError code, const std::string& message);
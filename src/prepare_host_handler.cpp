@@ -0,0 +1,98 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "prepare_host_handler.hpp"
+
+#include "connection.hpp"
+#include "pool.hpp"
+
+#define MAX_PREPARES_IN_FLIGHT 32
+
+namespace cass {
+
+PrepareHostHandler::PrepareHostHandler(Pool* pool, Connection* connection,
+                                       const PreparedRegistry::QueryVec& queries,
+                                       Callback callback)
+    : pool_(pool)
+    , connection_(connection)
+    , queries_(queries)
+    , next_query_(0)
+    , in_flight_(0)
+    , is_sending_(false)
+    , callback_(callback) {
+  pool_->add_prepare_handler(this);
+}
+
+PrepareHostHandler::~PrepareHostHandler() {
+  pool_->remove_prepare_handler(this);
+}
+
+void PrepareHostHandler::prepare() {
+  prepare_next();
+}
+
+void PrepareHostHandler::prepare_next() {
+  // Keep a reference because a request can fail while it's being sent and
+  // that can release the last callback's reference.
+  ScopedRefPtr<PrepareHostHandler> self(this);
+
+  is_sending_ = true;
+  while (next_query_ < queries_.size() &&
+         in_flight_ < MAX_PREPARES_IN_FLIGHT &&
+         connection_ != NULL && connection_->is_ready()) {
+    ScopedRefPtr<Handler> handler(
+          new PrepareCallback(this, queries_[next_query_]));
+    in_flight_++;
+    if (!connection_->execute(handler.get())) {
+      in_flight_--; // No streams available, wait for a response
+      break;
+    }
+    next_query_++;
+  }
+  is_sending_ = false;
+
+  if (in_flight_ == 0) {
+    // Either everything has been prepared or the connection can't take
+    // any more requests (it's out of streams or closing).
+    finish();
+  }
+}
+
+void PrepareHostHandler::on_connection_closed() {
+  // Requests that were still in flight have been dropped with the
+  // connection and might never call back.
+  ScopedRefPtr<PrepareHostHandler> self(this);
+  connection_ = NULL;
+  finish();
+}
+
+void PrepareHostHandler::finish() {
+  next_query_ = queries_.size();
+  if (callback_) {
+    Callback callback(callback_);
+    callback_.clear();
+    callback(this);
+  }
+}
+
+void PrepareHostHandler::on_prepared() {
+  in_flight_--;
+  if (!is_sending_) {
+    prepare_next();
+  }
+}
+
+} // namespace cass
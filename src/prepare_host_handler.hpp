@@ -0,0 +1,97 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_PREPARE_HOST_HANDLER_HPP_INCLUDED__
+#define __CASS_PREPARE_HOST_HANDLER_HPP_INCLUDED__
+
+#include "handler.hpp"
+#include "prepare_request.hpp"
+#include "prepared_registry.hpp"
+#include "ref_counted.hpp"
+#include "scoped_ptr.hpp"
+
+#include "third_party/boost/boost/function.hpp"
+
+namespace cass {
+
+class Connection;
+class Pool;
+class ResponseMessage;
+
+// Prepares a list of statements on a single connection. The statements are
+// pipelined with a bounded number in flight and the callback runs once every
+// statement has either been prepared or failed. Failures are ignored because
+// requests still fall back to preparing a statement after an UNPREPARED
+// error. The connection is owned by the pool, which tells the handler when
+// the connection closes.
+class PrepareHostHandler : public RefCounted<PrepareHostHandler> {
+public:
+  typedef boost::function1<void, PrepareHostHandler*> Callback;
+
+  PrepareHostHandler(Pool* pool, Connection* connection,
+                     const PreparedRegistry::QueryVec& queries,
+                     Callback callback = Callback());
+  ~PrepareHostHandler();
+
+  Connection* connection() const { return connection_; }
+
+  void prepare();
+
+  // Called by the pool before the connection is deleted. The remaining
+  // statements are skipped.
+  void on_connection_closed();
+
+private:
+  class PrepareCallback : public Handler {
+  public:
+    PrepareCallback(PrepareHostHandler* parent, const std::string& query)
+        : request_(new PrepareRequest())
+        , parent_(parent) {
+      request_->set_query(query);
+    }
+
+    virtual const Request* request() const { return request_.get(); }
+
+    virtual void on_set(ResponseMessage* response) { parent_->on_prepared(); }
+
+    virtual void on_error(CassError code, const std::string& message) {
+      parent_->on_prepared();
+    }
+
+    virtual void on_timeout() { parent_->on_prepared(); }
+
+  private:
+    ScopedRefPtr<PrepareRequest> request_;
+    ScopedRefPtr<PrepareHostHandler> parent_;
+  };
+
+  void prepare_next();
+  void on_prepared();
+  void finish();
+
+private:
+  SharedRefPtr<Pool> pool_;
+  Connection* connection_;
+  PreparedRegistry::QueryVec queries_;
+  size_t next_query_;
+  size_t in_flight_;
+  bool is_sending_;
+  Callback callback_;
+};
+
+} // namespace cass
+
+#endif
@@ -34,6 +34,12 @@ public:
 
   void set_query(const std::string& query) { query_ = query; }
 
+  // The keyspace the statement is prepared in and cached under. An empty
+  // keyspace means the connection's current keyspace is used.
+  const std::string& keyspace() const { return keyspace_; }
+
+  void set_keyspace(const std::string& keyspace) { keyspace_ = keyspace; }
+
   void set_query(const char* query, size_t query_length) {
     query_.assign(query, query_length);
   }
@@ -43,6 +49,7 @@ private:
 
 private:
   std::string query_;
+  std::string keyspace_;
 };
 
 } // namespace cass
@@ -32,4 +32,13 @@ CassStatement* cass_prepared_bind(const CassPrepared* prepared) {
   return CassStatement::to(execute);
 }
 
+CassError cass_prepared_column_index(const CassPrepared* prepared,
+                                     const char* name,
+                                     CassColumnHandle* output) {
+  if (!prepared->result()->metadata()->get_handle(name, output)) {
+    return CASS_ERROR_NAME_DOES_NOT_EXIST;
+  }
+  return CASS_OK;
+}
+
 } // extern "C"
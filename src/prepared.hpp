@@ -21,6 +21,8 @@
 #include "result_response.hpp"
 #include "scoped_ptr.hpp"
 
+#include "third_party/boost/boost/atomic.hpp"
+
 #include <string>
 
 namespace cass {
@@ -30,16 +32,30 @@ public:
   Prepared(const ResultResponse* result, const std::string& statement)
       : result_(result)
       , id_(result->prepared())
-      , statement_(statement) {}
+      , statement_(statement)
+      , is_result_metadata_stale_(false) {}
 
   const ScopedPtr<const ResultResponse>& result() const { return result_; }
   const std::string& id() const { return id_; }
   const std::string& statement() const { return statement_; }
 
+  // Executions only skip the result metadata while the metadata returned
+  // when the statement was prepared is still valid.
+  bool has_valid_result_metadata() const {
+    return result_->result_metadata() &&
+        !is_result_metadata_stale_.load(boost::memory_order_acquire);
+  }
+
+  // The result metadata is stale after the schema of its table changes
+  void invalidate_result_metadata() const {
+    is_result_metadata_stale_.store(true, boost::memory_order_release);
+  }
+
 private:
   ScopedPtr<const ResultResponse> result_;
   std::string id_;
   std::string statement_;
+  mutable boost::atomic<bool> is_result_metadata_stale_;
 };
 
 } // namespace cass
@@ -0,0 +1,412 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "prepared_cache.hpp"
+
+#include "prepared_registry.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "scoped_mutex.hpp"
+#include "serialization.hpp"
+#include "types.hpp"
+
+#include "third_party/boost/boost/bind.hpp"
+#include "third_party/boost/boost/utility/string_ref.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <string.h>
+
+// The file starts with the magic bytes and the protocol version (the
+// result metadata's format depends on it) followed by records. A record is
+// [int32 size][int32 checksum] followed by <keyspace><query><result body>,
+// each encoded as [int32 size][bytes]. The size and checksum cover the
+// rest of the record.
+#define PREPARED_CACHE_FILE_MAGIC "CPC2"
+#define PREPARED_CACHE_FILE_MAGIC_SIZE 4
+#define PREPARED_CACHE_RECORD_HEADER_SIZE (2 * sizeof(int32_t))
+
+namespace cass {
+
+// CRC-32 (IEEE 802.3). Records are only checked once per session so the
+// bitwise version is fast enough.
+static uint32_t crc32(const char* data, size_t size) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= static_cast<uint8_t>(data[i]);
+    for (int j = 0; j < 8; ++j) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+static void append_bytes(const char* data, size_t size, std::string* output) {
+  char size_buf[sizeof(int32_t)];
+  encode_int32(size_buf, static_cast<int32_t>(size));
+  output->append(size_buf, sizeof(int32_t));
+  output->append(data, size);
+}
+
+static bool read_bytes(const std::string& input, size_t* pos, std::string* output) {
+  if (input.size() - *pos < sizeof(int32_t)) {
+    return false;
+  }
+  int32_t size = 0;
+  decode_int32(const_cast<char*>(input.data() + *pos), size);
+  *pos += sizeof(int32_t);
+  if (size < 0 || input.size() - *pos < static_cast<size_t>(size)) {
+    return false;
+  }
+  output->assign(input.data() + *pos, size);
+  *pos += size;
+  return true;
+}
+
+static void append_record(const std::string& keyspace,
+                          const std::string& query,
+                          const Prepared* prepared,
+                          std::string* output) {
+  const ResultResponse* result = prepared->result().get();
+  std::string record;
+  append_bytes(keyspace.data(), keyspace.size(), &record);
+  append_bytes(query.data(), query.size(), &record);
+  append_bytes(result->buffer(), result->buffer_size(), &record);
+
+  char header_buf[PREPARED_CACHE_RECORD_HEADER_SIZE];
+  encode_int32(header_buf, static_cast<int32_t>(record.size()));
+  encode_int32(header_buf + sizeof(int32_t),
+               static_cast<int32_t>(crc32(record.data(), record.size())));
+  output->append(header_buf, PREPARED_CACHE_RECORD_HEADER_SIZE);
+  output->append(record);
+}
+
+enum RecordStatus {
+  RECORD_OK,
+  RECORD_END,      // No more records, the last one may have been cut short
+  RECORD_CORRUPT
+};
+
+static RecordStatus read_record(const std::string& input, size_t* pos,
+                                std::string* keyspace,
+                                std::string* query,
+                                std::string* body) {
+  if (input.size() - *pos < PREPARED_CACHE_RECORD_HEADER_SIZE) {
+    return RECORD_END;
+  }
+  int32_t size = 0;
+  int32_t checksum = 0;
+  char* header = const_cast<char*>(input.data() + *pos);
+  decode_int32(header, size);
+  decode_int32(header + sizeof(int32_t), checksum);
+  if (size < 0) {
+    return RECORD_CORRUPT;
+  }
+  *pos += PREPARED_CACHE_RECORD_HEADER_SIZE;
+  if (input.size() - *pos < static_cast<size_t>(size)) {
+    return RECORD_END; // Truncated by a partial write
+  }
+
+  std::string record(input.data() + *pos, size);
+  *pos += size;
+  if (static_cast<uint32_t>(checksum) != crc32(record.data(), record.size())) {
+    return RECORD_CORRUPT;
+  }
+
+  size_t record_pos = 0;
+  if (!read_bytes(record, &record_pos, keyspace) ||
+      !read_bytes(record, &record_pos, query) ||
+      !read_bytes(record, &record_pos, body) ||
+      record_pos != record.size()) {
+    return RECORD_CORRUPT;
+  }
+  return RECORD_OK;
+}
+
+static std::string file_header(int protocol_version) {
+  std::string header(PREPARED_CACHE_FILE_MAGIC, PREPARED_CACHE_FILE_MAGIC_SIZE);
+  char version_buf[sizeof(int32_t)];
+  encode_int32(version_buf, protocol_version);
+  header.append(version_buf, sizeof(int32_t));
+  return header;
+}
+
+static void append_to_file(const std::string& path, const std::string& data) {
+  // Records are small so they're appended in a single write
+  std::ofstream file(path.c_str(),
+                     std::ios::out | std::ios::binary | std::ios::app);
+  file.write(data.data(), data.size());
+}
+
+PreparedCache::PreparedCache(size_t max_size)
+  : max_size_(max_size)
+  , generation_(0) {
+  uv_mutex_init(&mutex_);
+  uv_mutex_init(&file_mutex_);
+}
+
+PreparedCache::~PreparedCache() {
+  uv_mutex_destroy(&mutex_);
+  uv_mutex_destroy(&file_mutex_);
+}
+
+ResponseFuture* PreparedCache::add(const std::string& keyspace,
+                                   ResponseFuture* future) {
+  Key key(keyspace, future->statement);
+
+  ScopedMutex lock(&mutex_);
+
+  EntryMap::iterator it = entries_.find(key);
+  if (it != entries_.end()) {
+    Entry& entry = it->second;
+    touch(entry);
+    if (entry.prepared) {
+      Address address = entry.address;
+      SharedRefPtr<Prepared> prepared = entry.prepared;
+      lock.unlock();
+      future->set_prepared(address, prepared);
+    } else {
+      entry.waiting.push_back(SharedRefPtr<ResponseFuture>(future));
+    }
+    return NULL;
+  }
+
+  insert(key).waiting.push_back(SharedRefPtr<ResponseFuture>(future));
+  lock.unlock();
+
+  ResponseFuture* request_future = new ResponseFuture();
+  request_future->statement = future->statement;
+  request_future->set_callback(
+        boost::bind(&PreparedCache::on_prepared,
+                    SharedRefPtr<PreparedCache>(this), key, _1),
+        NULL);
+  return request_future;
+}
+
+static bool is_from_table(const ScopedRefPtr<Metadata>& metadata,
+                          const std::string& keyspace,
+                          const std::string& table) {
+  if (!metadata || metadata->column_count() == 0) {
+    return false;
+  }
+  // Every column in the metadata is from the same table
+  const ColumnDefinition& def = metadata->get(0);
+  return boost::string_ref(def.keyspace, def.keyspace_size) == keyspace &&
+      (table.empty() || boost::string_ref(def.table, def.table_size) == table);
+}
+
+// Statements are matched by their bind variables as well as their result
+// so statements that don't return rows (and all statements prepared with
+// protocol version 1, which has no result metadata) are matched too.
+static bool is_prepared_from_table(const Prepared* prepared,
+                                   const std::string& keyspace,
+                                   const std::string& table) {
+  const ResultResponse* result = prepared->result().get();
+  return is_from_table(result->result_metadata(), keyspace, table) ||
+      is_from_table(result->metadata(), keyspace, table);
+}
+
+void PreparedCache::invalidate(const std::string& keyspace,
+                               const std::string& table) {
+  ScopedMutex lock(&mutex_);
+  // Statements being prepared now may have been prepared before the change
+  generation_++;
+  EntryMap::iterator it = entries_.begin();
+  while (it != entries_.end()) {
+    const SharedRefPtr<Prepared>& prepared = it->second.prepared;
+    if (prepared && is_prepared_from_table(prepared.get(), keyspace, table)) {
+      prepared->invalidate_result_metadata();
+      erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t PreparedCache::load(const std::string& path, int protocol_version,
+                           PreparedRegistry* registry) {
+  std::string contents;
+  {
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    if (file) {
+      contents.assign(std::istreambuf_iterator<char>(file),
+                      std::istreambuf_iterator<char>());
+    }
+  }
+
+  // Decode everything before using any of it so a corrupt file is skipped
+  // as a whole.
+  typedef std::vector<std::pair<Key, SharedRefPtr<Prepared> > > LoadedVec;
+  LoadedVec loaded;
+  std::string header = file_header(protocol_version);
+  bool is_valid = contents.compare(0, header.size(), header) == 0;
+  if (is_valid) {
+    size_t pos = header.size();
+    std::string keyspace, query, body;
+    RecordStatus status;
+    while ((status = read_record(contents, &pos,
+                                 &keyspace, &query, &body)) == RECORD_OK) {
+      char* buffer = new char[body.size()];
+      memcpy(buffer, body.data(), body.size());
+      ScopedPtr<ResultResponse> result(new ResultResponse());
+      result->set_buffer(buffer, body.size());
+      if (body.size() < sizeof(int32_t) ||
+          !result->decode(protocol_version, buffer, body.size()) ||
+          result->kind() != CASS_RESULT_KIND_PREPARED) {
+        status = RECORD_CORRUPT;
+        break;
+      }
+
+      SharedRefPtr<Prepared> prepared(new Prepared(result.release(), query));
+      // The schema may have changed while the statement was saved so
+      // don't skip the result metadata until it's prepared again.
+      prepared->invalidate_result_metadata();
+      loaded.push_back(std::make_pair(Key(keyspace, query), prepared));
+    }
+    if (status == RECORD_CORRUPT) {
+      is_valid = false;
+      loaded.clear();
+    }
+  }
+
+  if (!is_valid) {
+    // Start over with an empty file for this protocol version
+    std::ofstream file(path.c_str(),
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(header.data(), header.size());
+  }
+
+  size_t count = 0;
+  ScopedMutex lock(&mutex_);
+
+  path_ = path;
+
+  for (LoadedVec::const_iterator it = loaded.begin(),
+       end = loaded.end(); it != end; ++it) {
+    const Key& key = it->first;
+    const SharedRefPtr<Prepared>& prepared = it->second;
+    registry->add(prepared->id(), key.first, key.second);
+
+    // Statements already prepared or being prepared by this session are
+    // newer than the saved ones. Replacing a statement being prepared
+    // would let it be evicted before its futures are set.
+    if (entries_.find(key) == entries_.end()) {
+      insert(key).prepared = prepared;
+      count++;
+    }
+  }
+
+  return count;
+}
+
+PreparedCache::Entry& PreparedCache::insert(const Key& key) {
+  Entry& entry = entries_[key];
+  lru_.push_front(key);
+  entry.lru = lru_.begin();
+  entry.generation = generation_;
+  evict();
+  return entry;
+}
+
+void PreparedCache::erase(EntryMap::iterator it) {
+  lru_.erase(it->second.lru);
+  entries_.erase(it);
+}
+
+void PreparedCache::touch(Entry& entry) {
+  lru_.splice(lru_.begin(), lru_, entry.lru);
+}
+
+void PreparedCache::evict() {
+  KeyList::iterator it = lru_.end();
+  while (entries_.size() > max_size_ && it != lru_.begin()) {
+    --it;
+    EntryMap::iterator entry_it = entries_.find(*it);
+    // Statements still being prepared have futures waiting on them
+    if (entry_it->second.prepared) {
+      KeyList::iterator next = it;
+      ++next;
+      erase(entry_it);
+      it = next;
+    }
+  }
+}
+
+void PreparedCache::on_prepared(const SharedRefPtr<PreparedCache>& cache,
+                                const Key& key,
+                                CassFuture* future) {
+  ResponseFuture* request_future = static_cast<ResponseFuture*>(future->from());
+
+  Address address = request_future->get_host_address();
+  SharedRefPtr<Prepared> prepared;
+  if (!request_future->is_error()) {
+    ScopedPtr<ResultResponse> result(
+          static_cast<ResultResponse*>(request_future->release_result()));
+    if (result && result->kind() == CASS_RESULT_KIND_PREPARED) {
+      prepared.reset(new Prepared(result.release(), key.second));
+    }
+  }
+
+  FutureVec waiting;
+  std::string path;
+  {
+    ScopedMutex lock(&cache->mutex_);
+    EntryMap::iterator it = cache->entries_.find(key);
+    assert(it != cache->entries_.end());
+    waiting.swap(it->second.waiting);
+    if (prepared && it->second.generation != cache->generation_) {
+      // The schema changed while the statement was being prepared so its
+      // metadata could be stale. The waiting futures get the statement but
+      // it isn't cached and the result metadata isn't trusted.
+      prepared->invalidate_result_metadata();
+      cache->erase(it);
+    } else if (prepared) {
+      it->second.address = address;
+      it->second.prepared = prepared;
+      path = cache->path_;
+    } else {
+      // Don't cache failures, the next prepare tries again
+      cache->erase(it);
+    }
+  }
+
+  if (!path.empty()) {
+    // The file is written outside of the cache's lock. Appends from
+    // different threads are serialized so records aren't interleaved.
+    std::string record;
+    append_record(key.first, key.second, prepared.get(), &record);
+    ScopedMutex lock(&cache->file_mutex_);
+    append_to_file(path, record);
+  }
+
+  const Future::Error* error = request_future->get_error();
+  for (FutureVec::iterator it = waiting.begin(),
+       end = waiting.end(); it != end; ++it) {
+    if (prepared) {
+      (*it)->set_prepared(address, prepared);
+    } else if (error != NULL) {
+      (*it)->set_error_from_caller_with_host_address(address,
+                                                     error->code,
+                                                     error->message);
+    } else {
+      (*it)->set_error_from_caller_with_host_address(address,
+                                                     CASS_ERROR_LIB_UNEXPECTED_RESPONSE,
+                                                     "Unexpected response to a prepare request");
+    }
+  }
+}
+
+} // namespace cass
@@ -0,0 +1,112 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_PREPARED_CACHE_HPP_INCLUDED__
+#define __CASS_PREPARED_CACHE_HPP_INCLUDED__
+
+#include "address.hpp"
+#include "cassandra.h"
+#include "macros.hpp"
+#include "prepared.hpp"
+#include "ref_counted.hpp"
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <uv.h>
+
+namespace cass {
+
+class PreparedRegistry;
+class ResponseFuture;
+
+// Caches a session's prepared statements by keyspace and query. Concurrent
+// prepares of the same query share a single PREPARE request and later
+// prepares get the cached statement without a round trip. When the cache
+// is full the least recently used statements are evicted.
+class PreparedCache : public RefCounted<PreparedCache> {
+public:
+  PreparedCache(size_t max_size);
+  ~PreparedCache();
+
+  // Adds a future waiting for its statement to be prepared. The future is
+  // set right away if the statement is cached. Returns a new future that
+  // must be used to send the PREPARE request, or NULL if a request is
+  // already in-flight for the same keyspace and query.
+  ResponseFuture* add(const std::string& keyspace, ResponseFuture* future);
+
+  // Removes the statements that use a table that has changed and
+  // invalidates their result metadata. An empty table means every table in
+  // the keyspace. Statements being prepared while the change happens are
+  // not cached.
+  void invalidate(const std::string& keyspace, const std::string& table);
+
+  // Loads the statements saved to a file by a previous session so they
+  // don't have to be prepared again, then appends newly prepared statements
+  // to the same file. The loaded statements are also added to the registry
+  // so they are prepared on hosts that come up. A file that's corrupt or
+  // from another protocol version is replaced. Returns the number of
+  // statements loaded.
+  size_t load(const std::string& path, int protocol_version,
+              PreparedRegistry* registry);
+
+private:
+  // The keyspace is part of the key because the same query can refer to
+  // different tables and Cassandra includes the keyspace in prepared ids.
+  typedef std::pair<std::string, std::string> Key; // Keyspace and query
+
+  typedef std::vector<SharedRefPtr<ResponseFuture> > FutureVec;
+
+  // Most recently used first
+  typedef std::list<Key> KeyList;
+
+  struct Entry {
+    Address address;
+    SharedRefPtr<Prepared> prepared;
+    FutureVec waiting; // Only used while the request is in-flight
+    KeyList::iterator lru;
+    unsigned generation; // The cache's generation when it was added
+  };
+
+  typedef std::map<Key, Entry> EntryMap;
+
+  Entry& insert(const Key& key);
+  void erase(EntryMap::iterator it);
+  void touch(Entry& entry);
+  void evict();
+
+  static void on_prepared(const SharedRefPtr<PreparedCache>& cache,
+                          const Key& key,
+                          CassFuture* future);
+
+private:
+  uv_mutex_t mutex_;
+  uv_mutex_t file_mutex_;
+  EntryMap entries_;
+  KeyList lru_;
+  const size_t max_size_;
+  unsigned generation_; // Incremented by every schema change
+  std::string path_; // Empty if statements aren't saved
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PreparedCache);
+};
+
+} // namespace cass
+
+#endif
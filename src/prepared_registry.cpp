@@ -0,0 +1,66 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "prepared_registry.hpp"
+
+#include "scoped_mutex.hpp"
+
+namespace cass {
+
+PreparedRegistry::PreparedRegistry()
+  : unprepared_count_(0) {
+  uv_mutex_init(&mutex_);
+}
+
+PreparedRegistry::~PreparedRegistry() {
+  uv_mutex_destroy(&mutex_);
+}
+
+bool PreparedRegistry::add(const std::string& prepared_id,
+                           const std::string& keyspace,
+                           const std::string& query) {
+  ScopedMutex lock(&mutex_);
+  if (entries_.count(prepared_id) > 0) {
+    return false;
+  }
+  Entry& entry = entries_[prepared_id];
+  entry.keyspace = keyspace;
+  entry.query = query;
+  return true;
+}
+
+void PreparedRegistry::get_queries(const std::string& keyspace,
+                                   QueryVec* queries) const {
+  ScopedMutex lock(&mutex_);
+  for (EntryMap::const_iterator it = entries_.begin(),
+       end = entries_.end(); it != end; ++it) {
+    if (it->second.keyspace == keyspace) {
+      queries->push_back(it->second.query);
+    }
+  }
+}
+
+void PreparedRegistry::on_unprepared() {
+  ScopedMutex lock(&mutex_);
+  unprepared_count_++;
+}
+
+unsigned PreparedRegistry::unprepared_count() const {
+  ScopedMutex lock(&mutex_);
+  return unprepared_count_;
+}
+
+} // namespace cass
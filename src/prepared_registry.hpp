@@ -0,0 +1,71 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_PREPARED_REGISTRY_HPP_INCLUDED__
+#define __CASS_PREPARED_REGISTRY_HPP_INCLUDED__
+
+#include "macros.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <uv.h>
+
+namespace cass {
+
+// A session-wide record of the statements prepared by a session. It's used
+// to prepare statements on hosts that haven't seen them yet so executing a
+// prepared statement doesn't have to wait for an UNPREPARED error and an
+// extra round trip. This is accessed from multiple IO worker threads.
+class PreparedRegistry {
+public:
+  typedef std::vector<std::string> QueryVec;
+
+  PreparedRegistry();
+  ~PreparedRegistry();
+
+  // Returns false if the statement was already registered
+  bool add(const std::string& prepared_id,
+           const std::string& keyspace,
+           const std::string& query);
+
+  // Prepared ids depend on the keyspace so only statements prepared while
+  // using the same keyspace can be prepared again.
+  void get_queries(const std::string& keyspace, QueryVec* queries) const;
+
+  // Counts the UNPREPARED errors returned for this session's statements
+  void on_unprepared();
+  unsigned unprepared_count() const;
+
+private:
+  struct Entry {
+    std::string keyspace;
+    std::string query;
+  };
+
+  typedef std::map<std::string, Entry> EntryMap; // Keyed by prepared id
+
+  mutable uv_mutex_t mutex_;
+  EntryMap entries_;
+  unsigned unprepared_count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PreparedRegistry);
+};
+
+} // namespace cass
+
+#endif
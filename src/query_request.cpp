@@ -117,4 +117,77 @@ int QueryRequest::encode_v2(BufferVec* bufs) const {
   return length;
 }
 
+int32_t QueryRequest::body_size(int version) const {
+  // <query> [long string] + <consistency> [short]
+  int32_t size = sizeof(int32_t) + query().size() + sizeof(uint16_t);
+
+  if (version == 1) {
+    return size;
+  }
+
+  size += sizeof(uint8_t); // <flags> [byte]
+
+  if (values_count() > 0) { // <values> = <n><value_1>...<value_n>
+    int32_t values = values_size(version);
+    if (values < 0) {
+      return values;
+    }
+    size += sizeof(uint16_t) + values;
+  }
+
+  if (page_size() > 0) {
+    size += sizeof(int32_t); // [int]
+  }
+
+  if (!paging_state().empty()) {
+    size += sizeof(int32_t) + paging_state().size(); // [bytes]
+  }
+
+  if (serial_consistency() != 0) {
+    size += sizeof(uint16_t); // [short]
+  }
+
+  return size;
+}
+
+char* QueryRequest::encode_body(int version, char* output) const {
+  char* pos = encode_long_string(output, query().data(), query().size());
+  pos = encode_uint16(pos, consistency());
+
+  if (version == 1) {
+    return pos;
+  }
+
+  pos = encode_byte(pos, flags());
+
+  if (values_count() > 0) {
+    pos = encode_uint16(pos, values_count());
+    pos = encode_values(version, pos);
+  }
+
+  if (page_size() > 0) {
+    pos = encode_int32(pos, page_size());
+  }
+
+  if (!paging_state().empty()) {
+    pos = encode_long_string(pos, paging_state().data(), paging_state().size());
+  }
+
+  if (serial_consistency() != 0) {
+    pos = encode_uint16(pos, serial_consistency());
+  }
+
+  return pos;
+}
+
+uint8_t QueryRequest::flags() const {
+  uint8_t flags = 0;
+  if (values_count() > 0) flags |= CASS_QUERY_FLAG_VALUES;
+  if (skip_metadata()) flags |= CASS_QUERY_FLAG_SKIP_METADATA;
+  if (page_size() > 0) flags |= CASS_QUERY_FLAG_PAGE_SIZE;
+  if (!paging_state().empty()) flags |= CASS_QUERY_FLAG_PAGING_STATE;
+  if (serial_consistency() != 0) flags |= CASS_QUERY_FLAG_SERIAL_CONSISTENCY;
+  return flags;
+}
+
 } // namespace cass
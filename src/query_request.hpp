@@ -55,6 +55,10 @@ private:
   int encode_v1(BufferVec* bufs) const;
   int encode_v2(BufferVec* bufs) const;
 
+  int32_t body_size(int version) const;
+  char* encode_body(int version, char* output) const;
+  uint8_t flags() const;
+
 private:
   std::string query_;
 };
@@ -0,0 +1,53 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "rate_limiter.hpp"
+
+#include <algorithm>
+
+namespace cass {
+
+RateLimiter::RateLimiter(const RateLimitSettings& settings)
+  : interval_us_(std::max<uint64_t>(1, static_cast<uint64_t>(1000000.0 / settings.rate)))
+  , tolerance_us_(interval_us_ * (settings.burst > 0 ? settings.burst - 1 : 0))
+  , mode_(settings.mode)
+  , tat_us_(0) {}
+
+bool RateLimiter::acquire(uint64_t now_us, uint64_t max_delay_us,
+                          uint64_t* delay_us) {
+  uint64_t tat = tat_us_.load(boost::memory_order_relaxed);
+  while (true) {
+    uint64_t start = std::max(tat, now_us);
+    uint64_t delay = start > now_us + tolerance_us_
+                     ? start - now_us - tolerance_us_ : 0;
+    if (delay > 0 &&
+        (mode_ == CASS_RATE_LIMIT_MODE_FAIL || delay > max_delay_us)) {
+      return false;
+    }
+    if (tat_us_.compare_exchange_weak(tat, start + interval_us_,
+                                      boost::memory_order_acq_rel,
+                                      boost::memory_order_relaxed)) {
+      *delay_us = delay;
+      return true;
+    }
+  }
+}
+
+void RateLimiter::release() {
+  tat_us_.fetch_sub(interval_us_, boost::memory_order_acq_rel);
+}
+
+} // namespace cass
@@ -0,0 +1,80 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_RATE_LIMITER_HPP_INCLUDED__
+#define __CASS_RATE_LIMITER_HPP_INCLUDED__
+
+#include "cassandra.h"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include "third_party/boost/boost/atomic.hpp"
+#include "third_party/boost/boost/cstdint.hpp"
+
+#include <map>
+
+namespace cass {
+
+struct RateLimitSettings {
+  RateLimitSettings()
+    : rate(0.0)
+    , burst(0)
+    , mode(CASS_RATE_LIMIT_MODE_FAIL) {}
+
+  RateLimitSettings(double rate, unsigned burst, CassRateLimitMode mode)
+    : rate(rate)
+    , burst(burst)
+    , mode(mode) {}
+
+  double rate; // Requests per second
+  unsigned burst;
+  CassRateLimitMode mode;
+};
+
+typedef std::map<unsigned, RateLimitSettings> RateLimitSettingsMap;
+
+// A token bucket implemented using the generic cell rate algorithm (GCRA).
+// The whole bucket is a single "theoretical arrival time" so acquiring a
+// permit and refilling the bucket is one compare-and-swap without locks.
+class RateLimiter : public RefCounted<RateLimiter> {
+public:
+  RateLimiter(const RateLimitSettings& settings);
+
+  CassRateLimitMode mode() const { return mode_; }
+
+  // Returns false if no permit is available and the limiter fails fast, or
+  // if the permit would only be available more than "max_delay" from now.
+  // Otherwise a permit is reserved and "delay" is set to the time (in
+  // microseconds) until the request may be sent.
+  bool acquire(uint64_t now_us, uint64_t max_delay_us, uint64_t* delay_us);
+
+  // Gives back a permit reserved by acquire() for a request that wasn't
+  // sent after all.
+  void release();
+
+private:
+  const uint64_t interval_us_;
+  const uint64_t tolerance_us_;
+  const CassRateLimitMode mode_;
+  boost::atomic<uint64_t> tat_us_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RateLimiter);
+};
+
+} // namespace cass
+
+#endif
@@ -27,9 +27,19 @@ bool Request::encode( int version, int flags, int stream, BufferVec* bufs) const
   if (version == 1 || version == 2) {
     bufs->push_back(Buffer()); // Placeholder
 
-    int32_t length = encode(version, bufs);
-    if (length < 0) {
-      return false;
+    int32_t length = 0;
+    if (is_frozen_ && can_reuse_frame()) {
+      const Buffer& body = frozen_bodies_[version - 1];
+      if (!body.is_buffer()) {
+        return false;
+      }
+      bufs->push_back(body);
+      length = body.size();
+    } else {
+      length = encode(version, bufs);
+      if (length < 0) {
+        return false;
+      }
     }
 
     Buffer buf(CASS_HEADER_SIZE_V1_AND_V2);
@@ -47,4 +57,67 @@ bool Request::encode( int version, int flags, int stream, BufferVec* bufs) const
   return true;
 }
 
+void Request::freeze() {
+  is_frozen_ = false;
+  for (int version = 1; version <= 2; ++version) {
+    Buffer body;
+    if (encode_frozen_body(version, &body)) {
+      frozen_bodies_[version - 1] = body;
+    } else {
+      frozen_bodies_[version - 1] = Buffer();
+    }
+  }
+  is_frozen_ = true;
+}
+
+bool Request::encode_frozen_body(int version, Buffer* body) const {
+  BufferVec bufs;
+  int32_t length = encode(version, &bufs);
+  if (length < 0) {
+    return false;
+  }
+
+  *body = Buffer(length);
+  size_t pos = 0;
+  for (BufferVec::const_iterator it = bufs.begin(),
+       end = bufs.end(); it != end; ++it) {
+    pos = body->copy(pos, it->encoded_data(), it->encoded_size());
+  }
+
+  return true;
+}
+
+int32_t Request::frame_size(int version) const {
+  if (version != 1 && version != 2) {
+    return ENCODE_ERROR_UNSUPPORTED_PROTOCOL;
+  }
+
+  if (is_frozen_) {
+    // The shared body is written as is instead of being copied
+    return ENCODE_ERROR_NO_SINGLE_BUFFER;
+  }
+
+  int32_t size = body_size(version);
+  if (size < 0) {
+    return size;
+  }
+
+  return CASS_HEADER_SIZE_V1_AND_V2 + size;
+}
+
+void Request::encode_frame(int version, int flags, int stream,
+                           int32_t frame_size, char* output) const {
+  char* pos = output;
+  pos = encode_byte(pos, version);
+  pos = encode_byte(pos, flags);
+  pos = encode_byte(pos, stream);
+  pos = encode_byte(pos, opcode());
+  encode_int32(pos, frame_size - CASS_HEADER_SIZE_V1_AND_V2);
+  pos += sizeof(int32_t);
+
+  char* end = encode_body(version, pos);
+  assert(end == output + frame_size && "Frame size doesn't match its body");
+  (void)end;
+}
+
 } // namespace cass
@@ -17,6 +17,7 @@
 #ifndef __CASS_REQUEST_HPP_INCLUDED__
 #define __CASS_REQUEST_HPP_INCLUDED__
 
+#include "address.hpp"
 #include "buffer.hpp"
 #include "macros.hpp"
 #include "ref_counted.hpp"
@@ -28,23 +29,91 @@ class RequestMessage;
 class Request : public RefCounted<Request> {
 public:
   enum {
-    ENCODE_ERROR_UNSUPPORTED_PROTOCOL = -1
+    ENCODE_ERROR_UNSUPPORTED_PROTOCOL = -1,
+    ENCODE_ERROR_NO_SINGLE_BUFFER = -2
   };
 
   Request(uint8_t opcode)
-      : opcode_(opcode) {}
+      : opcode_(opcode)
+      , request_timeout_(0)
+      , request_class_(0)
+      , has_preferred_address_(false)
+      , is_frozen_(false) {}
 
   virtual ~Request() {}
 
   uint8_t opcode() const { return opcode_; }
 
+  // A timeout of zero means the cluster's request timeout is used
+  unsigned request_timeout() const { return request_timeout_; }
+
+  void set_request_timeout(unsigned timeout) { request_timeout_ = timeout; }
+
+  // A class of zero means the request only uses the session's rate limit
+  unsigned request_class() const { return request_class_; }
+
+  void set_request_class(unsigned request_class) {
+    request_class_ = request_class;
+  }
+
+  // The request is sent to the preferred host first, if it's up, before
+  // the hosts from the load balancing policy.
+  bool has_preferred_address() const { return has_preferred_address_; }
+  const Address& preferred_address() const { return preferred_address_; }
+
+  void set_preferred_address(const Address& address) {
+    preferred_address_ = address;
+    has_preferred_address_ = true;
+  }
+
   bool encode(int version, int flags, int stream, BufferVec* bufs) const;
 
+  // A frozen request's body is encoded once and shared by all its
+  // executions, only the header is encoded for each one. The request must
+  // not be changed after it's frozen.
+  void freeze();
+  void unfreeze() { is_frozen_ = false; }
+  bool is_frozen() const { return is_frozen_; }
+
+  // Single buffer encoding: the size of the whole frame (header and body)
+  // is computed first so it can be encoded into one contiguous buffer.
+  // A negative size means the request must use the buffer vector encoding.
+  int32_t frame_size(int version) const;
+
+  // An encoded frame is sent again when the request is retried on another
+  // connection unless the request's encoding could have changed.
+  virtual bool can_reuse_frame() const { return true; }
+
+  // Frames are returned to the arena as soon as they're written unless the
+  // request is expected to be sent again from the same frame.
+  virtual bool keeps_frame() const { return false; }
+
+  void encode_frame(int version, int flags, int stream,
+                    int32_t frame_size, char* output) const;
+
 protected:
   virtual int encode(int version, BufferVec* bufs) const = 0;
 
+  virtual int32_t body_size(int version) const {
+    return ENCODE_ERROR_NO_SINGLE_BUFFER;
+  }
+
+  // Returns the end of the encoded body
+  virtual char* encode_body(int version, char* output) const {
+    return output;
+  }
+
+private:
+  bool encode_frozen_body(int version, Buffer* body) const;
+
 private:
   uint8_t opcode_;
+  unsigned request_timeout_;
+  unsigned request_class_;
+  Address preferred_address_;
+  bool has_preferred_address_;
+  bool is_frozen_;
+  Buffer frozen_bodies_[2]; // Protocol versions 1 and 2
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Request);
@@ -0,0 +1,46 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_REQUEST_EXECUTOR_HPP_INCLUDED__
+#define __CASS_REQUEST_EXECUTOR_HPP_INCLUDED__
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace cass {
+
+class Future;
+class Request;
+
+// Sends requests on behalf of the helpers that issue follow-up requests from
+// a response's callback (the page iterator, scatter-gather and the scanner).
+// The session implements this.
+class RequestExecutor {
+public:
+  virtual ~RequestExecutor() {}
+
+  // Returns a future with an external reference. Its callback is never run
+  // inline on an IO thread, whatever the callback mode, and rate limits
+  // never block.
+  virtual Future* execute_internal(const Request* request) = 0;
+
+  // New requests shouldn't be sent once the executor has started closing
+  virtual bool is_closing() const = 0;
+};
+
+} // namespace cass
+
+#endif
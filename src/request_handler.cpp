@@ -22,6 +22,7 @@
 #include "io_worker.hpp"
 #include "pool.hpp"
 #include "prepare_handler.hpp"
+#include "prepare_request.hpp"
 #include "result_response.hpp"
 #include "row.hpp"
 #include "schema_change_handler.hpp"
@@ -32,6 +33,9 @@ namespace cass {
 void RequestHandler::on_set(ResponseMessage* response) {
   assert(connection_ != NULL);
   assert(!is_query_plan_exhausted_ && "Tried to set on a non-existent host");
+  if (pool_ != NULL) {
+    pool_->on_response_time((uv_hrtime() - start_time_) / 1000);
+  }
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT:
       on_result_response(response);
@@ -58,11 +62,16 @@ void RequestHandler::on_error(CassError code, const std::string& message) {
 
 void RequestHandler::on_timeout() {
   assert(!is_query_plan_exhausted_ && "Tried to timeout on a non-existent host");
+  if (pool_ != NULL) {
+    pool_->on_request_timeout();
+  }
   set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
 }
 
 void RequestHandler::set_io_worker(IOWorker* io_worker) {
   future_->set_loop(io_worker->loop());
+  future_->set_callback_mode(io_worker->config().callback_mode(),
+                             io_worker->callback_executor());
   io_worker_ = io_worker;
 }
 
@@ -112,7 +121,9 @@ void RequestHandler::return_connection() {
 
 void RequestHandler::return_connection_and_finish() {
   return_connection();
-  io_worker_->request_finished(this);
+  if (io_worker_ != NULL) { // Not set if the request never left the session
+    io_worker_->request_finished(this);
+  }
 }
 
 void RequestHandler::on_result_response(ResponseMessage* response) {
@@ -143,6 +154,17 @@ void RequestHandler::on_result_response(ResponseMessage* response) {
       set_response(response->response_body().release());
       break;
 
+    case CASS_RESULT_KIND_PREPARED:
+      if (request_->opcode() == CQL_OPCODE_PREPARE) {
+        const PrepareRequest* prepare = static_cast<const PrepareRequest*>(request_.get());
+        io_worker_->on_prepared(current_address_,
+                                connection_->keyspace(),
+                                prepare->query(),
+                                result->prepared());
+      }
+      set_response(response->response_body().release());
+      break;
+
     default:
       set_response(response->response_body().release());
       break;
@@ -154,6 +176,10 @@ void RequestHandler::on_error_response(ResponseMessage* response) {
       static_cast<ErrorResponse*>(response->response_body().get());
 
   if (error->code() == CQL_ERROR_UNPREPARED) {
+    io_worker_->logger()->debug("RequestHandler: Statement not prepared on host %s, preparing it",
+                                current_address_.to_string().c_str());
+    io_worker_->prepared_registry()->on_unprepared();
+
     ScopedRefPtr<PrepareHandler> prepare_handler(new PrepareHandler(this));
 
     if (prepare_handler->init(error->prepared_id())) {
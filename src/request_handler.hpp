@@ -22,6 +22,7 @@
 #include "handler.hpp"
 #include "host.hpp"
 #include "load_balancing.hpp"
+#include "prepared.hpp"
 #include "request.hpp"
 #include "response.hpp"
 #include "scoped_ptr.hpp"
@@ -39,9 +40,74 @@ class Pool;
 class ResponseFuture : public ResultFuture<Response> {
 public:
   ResponseFuture()
-      : ResultFuture<Response>(CASS_FUTURE_TYPE_RESPONSE) {}
+      : ResultFuture<Response>(CASS_FUTURE_TYPE_RESPONSE)
+      , is_cancelled_(false)
+      , is_internal_(false) {}
+
+  bool is_cancelled() const {
+    return is_cancelled_.load(boost::memory_order_acquire);
+  }
+
+  void cancel() {
+    is_cancelled_.store(true, boost::memory_order_release);
+    set_error_from_caller(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request cancelled");
+  }
+
+  // Futures returned by a session's prepared cache share the same prepared
+  // statement. These are set by the thread that finished preparing the
+  // statement so the callback (if any) runs on that thread.
+  void set_prepared(const Address& address,
+                    const SharedRefPtr<Prepared>& prepared) {
+    ScopedMutex lock(&mutex_);
+    if (is_set_) return; // The future was cancelled
+    address_ = address;
+    prepared_ = prepared;
+    internal_set(lock, true);
+  }
+
+  void set_error_from_caller_with_host_address(const Address& address,
+                                               CassError code,
+                                               const std::string& message) {
+    ScopedMutex lock(&mutex_);
+    address_ = address;
+    internal_set_error(code, message, lock, true);
+  }
+
+  SharedRefPtr<Prepared> release_prepared() {
+    ScopedMutex lock(&mutex_);
+    internal_wait(lock);
+    SharedRefPtr<Prepared> prepared(prepared_);
+    prepared_.reset();
+    return prepared;
+  }
+
+  // The driver's own futures (page iterator, scatter-gather and scanner)
+  // send their next request from the callback so it's never run inline on
+  // the IO thread. Set before the request is executed.
+  bool is_internal() const { return is_internal_; }
+  void set_internal() { is_internal_ = true; }
+
+  // Applies the session's callback mode, see cass_cluster_set_callback_mode()
+  void set_callback_mode(CassCallbackMode mode, CallbackExecutor* executor) {
+    switch (mode) {
+      case CASS_CALLBACK_MODE_INLINE:
+        // Internal callbacks use the work queue
+        if (!is_internal_) set_callback_inline();
+        break;
+      case CASS_CALLBACK_MODE_EXECUTOR:
+        set_callback_executor(executor);
+        break;
+      default:
+        break;
+    }
+  }
 
   std::string statement;
+
+private:
+  boost::atomic<bool> is_cancelled_;
+  bool is_internal_;
+  SharedRefPtr<Prepared> prepared_;
 };
 
 class RequestHandler : public Handler {
@@ -50,12 +116,17 @@ public:
       : request_(request)
       , future_(future)
       , is_query_plan_exhausted_(false)
+      , has_overflow_address_(false)
+      , start_time_(0)
+      , dispatch_time_(0)
       , io_worker_(NULL)
       , connection_(NULL)
       , pool_(NULL) {}
 
   virtual const Request* request() const { return request_.get(); }
 
+  virtual bool is_cancelled() const { return future_->is_cancelled(); }
+
   virtual void on_set(ResponseMessage* response);
   virtual void on_error(CassError code, const std::string& message);
   virtual void on_timeout();
@@ -76,6 +147,31 @@ public:
   bool get_current_host_address(Address* address);
   void next_host();
 
+  // Remembers the first host that was skipped for being at its
+  // concurrency limit.
+  void set_overflow_address(const Address& address) {
+    if (!has_overflow_address_) {
+      overflow_address_ = address;
+      has_overflow_address_ = true;
+    }
+  }
+
+  bool take_overflow_address(Address* address) {
+    if (!has_overflow_address_) return false;
+    *address = overflow_address_;
+    has_overflow_address_ = false;
+    return true;
+  }
+
+  void set_start_time(uint64_t start_time) { start_time_ = start_time; }
+
+  // The time (in microseconds, see uv_hrtime()) before which a rate
+  // limited request must not be sent.
+  uint64_t dispatch_time() const { return dispatch_time_; }
+  void set_dispatch_time(uint64_t dispatch_time) {
+    dispatch_time_ = dispatch_time;
+  }
+
   bool is_host_up(const Address& address) const;
 
   void set_response(Response* response);
@@ -92,6 +188,10 @@ private:
   ScopedRefPtr<ResponseFuture> future_;
   bool is_query_plan_exhausted_;
   Address current_address_;
+  bool has_overflow_address_;
+  Address overflow_address_;
+  uint64_t start_time_;
+  uint64_t dispatch_time_;
   ScopedPtr<QueryPlan> query_plan_;
   IOWorker* io_worker_;
   Connection* connection_;
@@ -46,9 +46,12 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
       response_body_.reset(new SupportedResponse());
       return true;
 
-    case CQL_OPCODE_RESULT:
-      response_body_.reset(new ResultResponse());
+    case CQL_OPCODE_RESULT: {
+      ResultResponse* result = new ResultResponse();
+      result->set_metadata_cache(metadata_cache_);
+      response_body_.reset(result);
       return true;
+    }
 
     case CQL_OPCODE_EVENT:
       response_body_.reset(new EventResponse());
@@ -67,6 +70,24 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
   }
 }
 
+void ResponseMessage::discard_body() {
+  is_body_discarded_ = true;
+  response_body_.reset();
+  row_stream_.reset();
+  body_buffer_pos_ = NULL;
+}
+
+void ResponseMessage::stream_rows(Metadata* metadata,
+                                  CassRowCallback callback, void* data) {
+  if (opcode_ != CQL_OPCODE_RESULT || is_body_discarded_ ||
+      body_buffer_pos_ != NULL || row_stream_) {
+    return;
+  }
+  row_stream_.reset(
+        new RowStream(static_cast<ResultResponse*>(response_body_.get()),
+                      metadata, callback, data));
+}
+
 int ResponseMessage::decode(int version, char* input, size_t size) {
   char* input_pos = input;
 
@@ -97,8 +118,12 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
         return -1;
       }
 
-      response_body_->set_buffer(new char[length_]);
-      body_buffer_pos_ = response_body_->buffer();
+      if (length_ > 0) {
+        // Return after the header so the caller has a chance to discard
+        // the body before it's allocated.
+        received_ = CASS_HEADER_SIZE_V1_AND_V2;
+        return input_pos - input;
+      }
     } else {
       // We haven't received all the data for the header. We consume the
       // entire buffer.
@@ -108,6 +133,11 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
     }
   }
 
+  if (!is_body_discarded_ && !row_stream_ && body_buffer_pos_ == NULL) {
+    response_body_->set_buffer(new char[length_], length_);
+    body_buffer_pos_ = response_body_->buffer();
+  }
+
   const size_t remaining = size - (input_pos - input);
   const size_t frame_size = CASS_HEADER_SIZE_V1_AND_V2 + length_;
 
@@ -116,22 +146,41 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
     size_t overage = received_ - frame_size;
     size_t needed = remaining - overage;
 
-    memcpy(body_buffer_pos_, input_pos, needed);
-    body_buffer_pos_ += needed;
-    input_pos += needed;
-    assert(body_buffer_pos_ == response_body_->buffer() + length_);
+    if (is_body_discarded_) {
+      input_pos += needed;
+    } else if (row_stream_) {
+      if (!row_stream_->append(version, input_pos, needed) ||
+          !row_stream_->finish(version)) {
+        is_body_error_ = true;
+        return -1;
+      }
+      row_stream_.reset();
+      input_pos += needed;
+    } else {
+      memcpy(body_buffer_pos_, input_pos, needed);
+      body_buffer_pos_ += needed;
+      input_pos += needed;
+      assert(body_buffer_pos_ == response_body_->buffer() + length_);
 
-    if (!response_body_->decode(version, response_body_->buffer(), length_)) {
-      is_body_error_ = true;
-      return -1;
+      if (!response_body_->decode(version, response_body_->buffer(), length_)) {
+        is_body_error_ = true;
+        return -1;
+      }
     }
 
     is_body_ready_ = true;
   } else {
     // We haven't received all the data for the frame. We consume the entire
     // buffer.
-    memcpy(body_buffer_pos_, input_pos, remaining);
-    body_buffer_pos_ += remaining;
+    if (row_stream_) {
+      if (!row_stream_->append(version, input_pos, remaining)) {
+        is_body_error_ = true;
+        return -1;
+      }
+    } else if (!is_body_discarded_) {
+      memcpy(body_buffer_pos_, input_pos, remaining);
+      body_buffer_pos_ += remaining;
+    }
     return size;
   }
 
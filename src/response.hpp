@@ -19,29 +19,41 @@
 
 #include "constants.hpp"
 #include "macros.hpp"
+#include "row_stream.hpp"
 #include "scoped_ptr.hpp"
 
 #include "third_party/boost/boost/cstdint.hpp"
 
 namespace cass {
 
+class Metadata;
+class MetadataCache;
+
 class Response {
 public:
   Response(uint8_t opcode)
-      : opcode_(opcode) {}
+      : opcode_(opcode)
+      , buffer_size_(0) {}
 
   virtual ~Response() {}
 
   uint8_t opcode() const { return opcode_; }
 
   char* buffer() { return buffer_.get(); }
-  void set_buffer(char* buffer) { buffer_.reset(buffer); }
+  const char* buffer() const { return buffer_.get(); }
+  size_t buffer_size() const { return buffer_size_; }
+
+  void set_buffer(char* buffer, size_t size) {
+    buffer_.reset(buffer);
+    buffer_size_ = size;
+  }
 
   virtual bool decode(int version, char* buffer, size_t size) = 0;
 
 private:
   uint8_t opcode_;
   ScopedPtr<char[]> buffer_;
+  size_t buffer_size_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Response);
@@ -60,18 +72,39 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
-      , body_buffer_pos_(NULL) {}
+      , is_body_discarded_(false)
+      , body_buffer_pos_(NULL)
+      , metadata_cache_(NULL) {}
 
   uint8_t opcode() const { return opcode_; }
 
   int8_t stream() const { return stream_; }
 
+  int32_t length() const { return length_; }
+
   ScopedPtr<Response>& response_body() { return response_body_; }
 
+  bool is_header_received() const { return is_header_received_; }
+
   bool is_body_ready() const { return is_body_ready_; }
 
+  // The remaining body bytes are skipped instead of being buffered and
+  // decoded. The response body is not available after this is called.
+  bool is_body_discarded() const { return is_body_discarded_; }
+  void discard_body();
+
   int decode(int version, char* input, size_t size);
 
+  // Used to share the metadata of decoded results
+  void set_metadata_cache(MetadataCache* cache) { metadata_cache_ = cache; }
+
+  // The rows of a RESULT body are passed to the callback as they arrive
+  // instead of buffering the whole body. This must be called before any
+  // of the body is received. The metadata is used if the result's metadata
+  // was skipped.
+  void stream_rows(Metadata* metadata, CassRowCallback callback, void* data);
+  bool is_streaming_rows() const { return row_stream_.get() != NULL; }
+
 private:
   bool allocate_body(int8_t opcode);
 
@@ -89,8 +122,11 @@ private:
 
   bool is_body_ready_;
   bool is_body_error_;
+  bool is_body_discarded_;
   ScopedPtr<Response> response_body_;
   char* body_buffer_pos_;
+  MetadataCache* metadata_cache_;
+  ScopedPtr<RowStream> row_stream_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResponseMessage);
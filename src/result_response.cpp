@@ -17,9 +17,143 @@
 #include "result_response.hpp"
 
 #include "metadata.hpp"
+#include "metadata_cache.hpp"
 #include "serialization.hpp"
 #include "types.hpp"
 
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+// "size" is the size of an encoded value
+template<class T>
+struct ColumnType;
+
+template<>
+struct ColumnType<cass_int32_t> {
+  static const int32_t size = sizeof(int32_t);
+  static bool is_valid(uint16_t type) {
+    return type == CASS_VALUE_TYPE_INT;
+  }
+  static void decode(char* input, cass_int32_t* output) {
+    cass::decode_int32(input, *output);
+  }
+};
+
+template<>
+struct ColumnType<cass_int64_t> {
+  static const int32_t size = sizeof(int64_t);
+  static bool is_valid(uint16_t type) {
+    return type == CASS_VALUE_TYPE_BIGINT ||
+        type == CASS_VALUE_TYPE_COUNTER ||
+        type == CASS_VALUE_TYPE_TIMESTAMP;
+  }
+  static void decode(char* input, cass_int64_t* output) {
+    cass::decode_int64(input, *output);
+  }
+};
+
+template<>
+struct ColumnType<cass_float_t> {
+  static const int32_t size = sizeof(float);
+  static bool is_valid(uint16_t type) {
+    return type == CASS_VALUE_TYPE_FLOAT;
+  }
+  static void decode(char* input, cass_float_t* output) {
+    cass::decode_float(input, *output);
+  }
+};
+
+template<>
+struct ColumnType<cass_double_t> {
+  static const int32_t size = sizeof(double);
+  static bool is_valid(uint16_t type) {
+    return type == CASS_VALUE_TYPE_DOUBLE;
+  }
+  static void decode(char* input, cass_double_t* output) {
+    cass::decode_double(input, *output);
+  }
+};
+
+template<>
+struct ColumnType<cass_bool_t> {
+  static const int32_t size = sizeof(uint8_t);
+  static bool is_valid(uint16_t type) {
+    return type == CASS_VALUE_TYPE_BOOLEAN;
+  }
+  static void decode(char* input, cass_bool_t* output) {
+    uint8_t byte;
+    cass::decode_byte(input, byte);
+    *output = static_cast<cass_bool_t>(byte);
+  }
+};
+
+template<>
+struct ColumnType<CassUuid> {
+  static const int32_t size = sizeof(CassUuid);
+  static bool is_valid(uint16_t type) {
+    return type == CASS_VALUE_TYPE_UUID ||
+        type == CASS_VALUE_TYPE_TIMEUUID;
+  }
+  static void decode(char* input, CassUuid* output) {
+    memcpy(*output, input, sizeof(CassUuid));
+  }
+};
+
+// Decodes a column of all the rows in a single pass over the row data
+// instead of decoding every value of every row.
+template<class T>
+CassError get_column(const CassResult* result, size_t index,
+                     T* output, size_t count, cass_uint8_t* null_bitmap) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS ||
+      index >= static_cast<size_t>(result->column_count())) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  if (!ColumnType<T>::is_valid(result->metadata()->get(index).type)) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+
+  size_t row_count = std::min(count, static_cast<size_t>(result->row_count()));
+  if (null_bitmap != NULL) {
+    memset(null_bitmap, 0, (row_count + 7) / 8);
+  }
+
+  const size_t column_count = result->column_count();
+  char* position = result->rows_begin();
+  char* end = result->rows_begin() + result->rows_size();
+  for (size_t row = 0; row < row_count; ++row) {
+    for (size_t column = 0; column < column_count; ++column) {
+      int32_t size = 0;
+      if (static_cast<size_t>(end - position) < sizeof(int32_t)) {
+        return CASS_ERROR_LIB_UNEXPECTED_RESPONSE;
+      }
+      position = cass::decode_int32(position, size);
+      if (size > end - position) {
+        return CASS_ERROR_LIB_UNEXPECTED_RESPONSE;
+      }
+      if (column == index) {
+        // Empty values, and values of the wrong size, are null
+        if (size != ColumnType<T>::size) {
+          memset(&output[row], 0, sizeof(T));
+          if (null_bitmap != NULL) {
+            null_bitmap[row / 8] |= static_cast<cass_uint8_t>(1 << (row % 8));
+          }
+        } else {
+          ColumnType<T>::decode(position, &output[row]);
+        }
+      }
+      if (size > 0) {
+        position += size;
+      }
+    }
+  }
+
+  return CASS_OK;
+}
+
+} // namespace
 
 extern "C" {
 
@@ -70,10 +204,76 @@ const CassRow* cass_result_first_row(const CassResult* result) {
   return NULL;
 }
 
+CassError cass_result_column_index(const CassResult* result,
+                                   const char* name,
+                                   CassColumnHandle* output) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS ||
+      !result->metadata()->get_handle(name, output)) {
+    return CASS_ERROR_NAME_DOES_NOT_EXIST;
+  }
+  return CASS_OK;
+}
+
+const CassRow* cass_result_row_at(const CassResult* result, cass_size_t index) {
+  if (result->kind() == CASS_RESULT_KIND_ROWS &&
+      index < static_cast<size_t>(result->row_count())) {
+    return CassRow::to(result->row_at(index));
+  }
+  return NULL;
+}
+
 cass_bool_t cass_result_has_more_pages(const CassResult* result) {
   return static_cast<cass_bool_t>(result->has_more_pages());
 }
 
+CassError cass_result_get_column_int32(const CassResult* result,
+                                       size_t index,
+                                       cass_int32_t* output,
+                                       size_t count,
+                                       cass_uint8_t* null_bitmap) {
+  return get_column(result, index, output, count, null_bitmap);
+}
+
+CassError cass_result_get_column_int64(const CassResult* result,
+                                       size_t index,
+                                       cass_int64_t* output,
+                                       size_t count,
+                                       cass_uint8_t* null_bitmap) {
+  return get_column(result, index, output, count, null_bitmap);
+}
+
+CassError cass_result_get_column_float(const CassResult* result,
+                                       size_t index,
+                                       cass_float_t* output,
+                                       size_t count,
+                                       cass_uint8_t* null_bitmap) {
+  return get_column(result, index, output, count, null_bitmap);
+}
+
+CassError cass_result_get_column_double(const CassResult* result,
+                                        size_t index,
+                                        cass_double_t* output,
+                                        size_t count,
+                                        cass_uint8_t* null_bitmap) {
+  return get_column(result, index, output, count, null_bitmap);
+}
+
+CassError cass_result_get_column_bool(const CassResult* result,
+                                      size_t index,
+                                      cass_bool_t* output,
+                                      size_t count,
+                                      cass_uint8_t* null_bitmap) {
+  return get_column(result, index, output, count, null_bitmap);
+}
+
+CassError cass_result_get_column_uuid(const CassResult* result,
+                                      size_t index,
+                                      CassUuid* output,
+                                      size_t count,
+                                      cass_uint8_t* null_bitmap) {
+  return get_column(result, index, output, count, null_bitmap);
+}
+
 } // extern "C"
 
 namespace cass {
@@ -91,7 +291,7 @@ bool ResultResponse::decode(int version, char* input, size_t size) {
       return true;
       break;
     case CASS_RESULT_KIND_ROWS:
-      return decode_rows(buffer);
+      return decode_rows(buffer, input + size);
       break;
     case CASS_RESULT_KIND_SET_KEYSPACE:
       return decode_set_keyspace(buffer);
@@ -108,6 +308,63 @@ bool ResultResponse::decode(int version, char* input, size_t size) {
   return false;
 }
 
+// Decodes the column specs into "metadata", or only skips over them if
+// "metadata" is NULL. Columns from a global table spec get its keyspace
+// and table.
+static char* decode_column_specs(char* input, int32_t column_count,
+                                 bool global_table_spec, Metadata* metadata) {
+  char* buffer = input;
+
+  char* keyspace = NULL;
+  size_t keyspace_size = 0;
+  char* table = NULL;
+  size_t table_size = 0;
+
+  if (global_table_spec) {
+    buffer = decode_string(buffer, &keyspace, keyspace_size);
+    buffer = decode_string(buffer, &table, table_size);
+  }
+
+  for (int i = 0; i < column_count; ++i) {
+    ColumnDefinition def;
+
+    def.index = i;
+
+    if (!global_table_spec) {
+      buffer = decode_string(buffer, &def.keyspace, def.keyspace_size);
+      buffer = decode_string(buffer, &def.table, def.table_size);
+    } else {
+      def.keyspace = keyspace;
+      def.keyspace_size = keyspace_size;
+      def.table = table;
+      def.table_size = table_size;
+    }
+
+    buffer = decode_string(buffer, &def.name, def.name_size);
+    buffer = decode_option(buffer, def.type, &def.class_name,
+                           def.class_name_size);
+
+    if (def.type == CASS_VALUE_TYPE_SET ||
+        def.type == CASS_VALUE_TYPE_LIST ||
+        def.type == CASS_VALUE_TYPE_MAP) {
+      buffer = decode_option(buffer, def.collection_primary_type,
+                             &def.collection_primary_class,
+                             def.collection_primary_class_size);
+    }
+
+    if (def.type == CASS_VALUE_TYPE_MAP) {
+      buffer = decode_option(buffer, def.collection_secondary_type,
+                             &def.collection_secondary_class,
+                             def.collection_secondary_class_size);
+    }
+
+    if (metadata != NULL) {
+      metadata->insert(def);
+    }
+  }
+  return buffer;
+}
+
 char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<Metadata>* metadata) {
   int32_t flags = 0;
   char* buffer = decode_int32(input, flags);
@@ -124,43 +381,30 @@ char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<Metadata>* metad
 
   if (!(flags & CASS_RESULT_FLAG_NO_METADATA)) {
     bool global_table_spec = flags & CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
+    char* specs = buffer;
 
     if (global_table_spec) {
-      buffer = decode_string(buffer, &keyspace_, keyspace_size_);
-      buffer = decode_string(buffer, &table_, table_size_);
+      char* pos = decode_string(specs, &keyspace_, keyspace_size_);
+      decode_string(pos, &table_, table_size_);
     }
 
-    metadata->reset(new Metadata(column_count));
-
-    for (int i = 0; i < column_count; ++i) {
-      ColumnDefinition def;
-
-      def.index = i;
-
-      if (!global_table_spec) {
-        buffer = decode_string(buffer, &def.keyspace, def.keyspace_size);
-        buffer = decode_string(buffer, &def.table, def.table_size);
-      }
-
-      buffer = decode_string(buffer, &def.name, def.name_size);
-      buffer = decode_option(buffer, def.type, &def.class_name,
-                             def.class_name_size);
-
-      if (def.type == CASS_VALUE_TYPE_SET ||
-          def.type == CASS_VALUE_TYPE_LIST ||
-          def.type == CASS_VALUE_TYPE_MAP) {
-        buffer = decode_option(buffer, def.collection_primary_type,
-                               &def.collection_primary_class,
-                               def.collection_primary_class_size);
-      }
-
-      if (def.type == CASS_VALUE_TYPE_MAP) {
-        buffer = decode_option(buffer, def.collection_secondary_type,
-                               &def.collection_secondary_class,
-                               def.collection_secondary_class_size);
-      }
+    if (metadata_cache_ == NULL) {
+      metadata->reset(new Metadata(column_count));
+      return decode_column_specs(specs, column_count, global_table_spec,
+                                 metadata->get());
+    }
 
-      (*metadata)->insert(def);
+    buffer = decode_column_specs(specs, column_count, global_table_spec, NULL);
+    size_t specs_size = buffer - specs;
+
+    metadata->reset(metadata_cache_->get(global_table_spec, column_count,
+                                         specs, specs_size));
+    if (!*metadata) {
+      Metadata* decoded = new Metadata(column_count, specs, specs_size);
+      metadata->reset(decoded);
+      decode_column_specs(decoded->specs(), column_count, global_table_spec,
+                          decoded);
+      metadata_cache_->put(global_table_spec, decoded);
     }
   }
   return buffer;
@@ -173,9 +417,39 @@ void ResultResponse::decode_first_row() {
   }
 }
 
-bool ResultResponse::decode_rows(char* input) {
+const Row* ResultResponse::row_at(size_t index) const {
+  assert(index < static_cast<size_t>(row_count_));
+  const RowVec* rows = row_index_.load(boost::memory_order_acquire);
+  if (rows == NULL) {
+    rows = build_row_index();
+  }
+  return &(*rows)[index];
+}
+
+const ResultResponse::RowVec* ResultResponse::build_row_index() const {
+  // Values reference the response's buffer so only the cell offsets and
+  // sizes are copied. Concurrent callers may race to build the index; the
+  // first one to publish wins and the others discard their copy.
+  RowVec* rows = new RowVec(row_count_, Row(this));
+  char* position = rows_begin_;
+  for (RowVec::iterator it = rows->begin(), end = rows->end(); it != end; ++it) {
+    it->values.reserve(column_count());
+    position = decode_row(position, this, it->values);
+  }
+
+  RowVec* expected = NULL;
+  if (!row_index_.compare_exchange_strong(expected, rows,
+                                          boost::memory_order_acq_rel)) {
+    delete rows;
+    return expected;
+  }
+  return rows;
+}
+
+bool ResultResponse::decode_rows(char* input, char* end) {
   char* buffer = decode_metadata(input, &metadata_);
-  rows_ = decode_int32(buffer, row_count_);
+  rows_ = rows_begin_ = decode_int32(buffer, row_count_);
+  rows_size_ = end - rows_begin_;
   return true;
 }
 
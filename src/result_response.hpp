@@ -23,6 +23,7 @@
 #include "response.hpp"
 #include "row.hpp"
 
+#include "third_party/boost/boost/atomic.hpp"
 #include "third_party/boost/boost/utility/string_ref.hpp"
 
 #include <map>
@@ -31,6 +32,7 @@
 
 namespace cass {
 
+class MetadataCache;
 class ResultIterator;
 
 class ResultResponse : public Response {
@@ -50,10 +52,18 @@ public:
       , table_(NULL)
       , table_size_(0)
       , row_count_(0)
-      , rows_(NULL) {
+      , rows_begin_(NULL)
+      , rows_size_(0)
+      , rows_(NULL)
+      , row_index_(NULL)
+      , metadata_cache_(NULL) {
     first_row_.set_result(this);
   }
 
+  ~ResultResponse() {
+    delete row_index_.load();
+  }
+
   int32_t kind() const { return kind_; }
 
   bool has_more_pages() const { return has_more_pages_; }
@@ -70,6 +80,10 @@ public:
 
   const ScopedRefPtr<Metadata>& result_metadata() const { return result_metadata_; }
 
+  // Decoded metadata is shared with other results that have the same
+  // column specs. The cache is only used while decoding.
+  void set_metadata_cache(MetadataCache* cache) { metadata_cache_ = cache; }
+
   std::string paging_state() const {
     return std::string(paging_state_, paging_state_size_);
   }
@@ -84,10 +98,23 @@ public:
 
   char* rows() const { return rows_; }
 
+  // The first row, rows() is after the first row once it's decoded
+  char* rows_begin() const { return rows_begin_; }
+
   int32_t row_count() const { return row_count_; }
 
+  // The size of the encoded rows in bytes
+  size_t rows_size() const { return rows_size_; }
+
+  // Used after the rows have been passed to a row callback
+  void clear_rows() { row_count_ = 0; }
+
   const Row& first_row() const { return first_row_; }
 
+  // Random access to rows. The first call decodes every row into an index
+  // so that later calls are O(1) and can be made from multiple threads.
+  const Row* row_at(size_t index) const;
+
   size_t find_column_indices(boost::string_ref name,
                              Metadata::IndexVec* result) const;
 
@@ -96,9 +123,13 @@ public:
   void decode_first_row();
 
 private:
+  typedef std::vector<Row> RowVec;
+
+  const RowVec* build_row_index() const;
+
   char* decode_metadata(char* input, ScopedRefPtr<Metadata>* metadata);
 
-  bool decode_rows(char* input);
+  bool decode_rows(char* input, char* end);
 
   bool decode_set_keyspace(char* input);
 
@@ -122,8 +153,12 @@ private:
   char* table_; // rows, and schema change
   size_t table_size_;
   int32_t row_count_;
+  char* rows_begin_;
+  size_t rows_size_;
   char* rows_;
   Row first_row_;
+  mutable boost::atomic<RowVec*> row_index_;
+  MetadataCache* metadata_cache_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResultResponse);
@@ -35,6 +35,11 @@ const CassValue* cass_row_get_column_by_name(const CassRow* row,
   return CassValue::to(row->get_by_name(name));
 }
 
+const CassValue* cass_row_get_column_by_handle(const CassRow* row,
+                                               CassColumnHandle handle) {
+  return cass_row_get_column(row, handle.index);
+}
+
 } // extern "C"
 
 namespace cass {
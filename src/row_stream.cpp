@@ -0,0 +1,258 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "row_stream.hpp"
+
+#include "constants.hpp"
+#include "metadata.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+#include "types.hpp"
+
+#include <string.h>
+
+namespace {
+
+// Checks that values have arrived before they're decoded so that a
+// partial body is never read past its end.
+class Reader {
+public:
+  Reader(const char* data, size_t size)
+    : pos_(data)
+    , end_(data + size) {}
+
+  const char* position() const { return pos_; }
+
+  bool skip(size_t size) {
+    if (static_cast<size_t>(end_ - pos_) < size) return false;
+    pos_ += size;
+    return true;
+  }
+
+  bool read_int32(int32_t* output) {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(int32_t)) return false;
+    pos_ = cass::decode_int32(const_cast<char*>(pos_), *output);
+    return true;
+  }
+
+  bool read_uint16(uint16_t* output) {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(uint16_t)) return false;
+    pos_ = cass::decode_uint16(const_cast<char*>(pos_), *output);
+    return true;
+  }
+
+  bool skip_string() {
+    uint16_t size;
+    return read_uint16(&size) && skip(size);
+  }
+
+  bool skip_bytes() {
+    int32_t size;
+    return read_int32(&size) && (size < 0 || skip(size));
+  }
+
+  bool skip_option(uint16_t* type) {
+    return read_uint16(type) &&
+        (*type != CASS_VALUE_TYPE_CUSTOM || skip_string());
+  }
+
+private:
+  const char* pos_;
+  const char* end_;
+};
+
+// The size of the kind, metadata and row count of a rows result. Returns
+// false if they haven't all arrived.
+bool rows_header_size(const char* data, size_t size, size_t* output) {
+  Reader reader(data, size);
+
+  int32_t kind, flags, column_count;
+  if (!reader.read_int32(&kind) ||
+      !reader.read_int32(&flags) ||
+      !reader.read_int32(&column_count)) {
+    return false;
+  }
+
+  if ((flags & CASS_RESULT_FLAG_HAS_MORE_PAGES) && !reader.skip_bytes()) {
+    return false;
+  }
+
+  if (!(flags & CASS_RESULT_FLAG_NO_METADATA)) {
+    bool global_table_spec = flags & CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
+
+    if (global_table_spec && !(reader.skip_string() && reader.skip_string())) {
+      return false;
+    }
+
+    for (int i = 0; i < column_count; ++i) {
+      if (!global_table_spec && !(reader.skip_string() && reader.skip_string())) {
+        return false;
+      }
+
+      uint16_t type, sub_type;
+      if (!reader.skip_string() || !reader.skip_option(&type)) {
+        return false;
+      }
+
+      if ((type == CASS_VALUE_TYPE_SET ||
+           type == CASS_VALUE_TYPE_LIST ||
+           type == CASS_VALUE_TYPE_MAP) && !reader.skip_option(&sub_type)) {
+        return false;
+      }
+
+      if (type == CASS_VALUE_TYPE_MAP && !reader.skip_option(&sub_type)) {
+        return false;
+      }
+    }
+  }
+
+  int32_t row_count;
+  if (!reader.read_int32(&row_count)) {
+    return false;
+  }
+
+  *output = reader.position() - data;
+  return true;
+}
+
+// The size of the row at the start of the data. Returns false if the whole
+// row hasn't arrived.
+bool row_size(const char* data, size_t size, int column_count,
+              size_t* output) {
+  Reader reader(data, size);
+  for (int i = 0; i < column_count; ++i) {
+    if (!reader.skip_bytes()) {
+      return false;
+    }
+  }
+  *output = reader.position() - data;
+  return true;
+}
+
+} // namespace
+
+namespace cass {
+
+RowStream::RowStream(ResultResponse* result, Metadata* metadata,
+                     CassRowCallback callback, void* data)
+  : result_(result)
+  , metadata_(metadata)
+  , callback_(callback)
+  , data_(data)
+  , state_(STATE_HEADER)
+  , remaining_rows_(0)
+  , row_(result) {}
+
+bool RowStream::append(int version, const char* input, size_t size) {
+  buffer_.insert(buffer_.end(), input, input + size);
+
+  switch (state_) {
+    case STATE_HEADER:
+      return decode_header(version);
+    case STATE_ROWS:
+      return decode_rows();
+    default:
+      return true;
+  }
+}
+
+bool RowStream::finish(int version) {
+  switch (state_) {
+    case STATE_ROWS:
+      if (remaining_rows_ != 0 || !buffer_.empty()) {
+        return false;
+      }
+      result_->clear_rows();
+      return true;
+
+    case STATE_BUFFERED: {
+      char* body = new char[buffer_.size()];
+      memcpy(body, &buffer_[0], buffer_.size());
+      result_->set_buffer(body, buffer_.size());
+      return result_->decode(version, body, buffer_.size());
+    }
+
+    default:
+      return false; // The rows header never arrived
+  }
+}
+
+bool RowStream::decode_header(int version) {
+  if (buffer_.size() < sizeof(int32_t)) {
+    return true;
+  }
+
+  int32_t kind;
+  decode_int32(&buffer_[0], kind);
+  if (kind != CASS_RESULT_KIND_ROWS) {
+    state_ = STATE_BUFFERED;
+    return true;
+  }
+
+  size_t size;
+  if (!rows_header_size(&buffer_[0], buffer_.size(), &size)) {
+    return true;
+  }
+
+  // The result keeps the header because its metadata references it
+  char* header = new char[size];
+  memcpy(header, &buffer_[0], size);
+  result_->set_buffer(header, size);
+  if (!result_->decode(version, header, size)) {
+    return false;
+  }
+
+  // Executions that skip the metadata use the prepared statement's
+  if (result_->no_metadata()) {
+    if (metadata_ == NULL) {
+      return false;
+    }
+    result_->set_metadata(metadata_);
+  }
+
+  buffer_.erase(buffer_.begin(), buffer_.begin() + size);
+  remaining_rows_ = result_->row_count();
+  row_.values.reserve(result_->column_count());
+  state_ = STATE_ROWS;
+
+  return decode_rows();
+}
+
+bool RowStream::decode_rows() {
+  if (buffer_.empty()) {
+    return true;
+  }
+
+  char* data = &buffer_[0];
+  const int column_count = result_->column_count();
+  size_t pos = 0;
+  size_t size = 0;
+
+  while (remaining_rows_ > 0 &&
+         row_size(data + pos, buffer_.size() - pos, column_count, &size)) {
+    decode_row(data + pos, result_, row_.values);
+    callback_(CassRow::to(&row_), data_);
+    pos += size;
+    --remaining_rows_;
+  }
+
+  buffer_.erase(buffer_.begin(), buffer_.begin() + pos);
+
+  // Nothing follows the last row
+  return remaining_rows_ > 0 || buffer_.empty();
+}
+
+} // namespace cass
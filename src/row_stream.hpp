@@ -0,0 +1,72 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_ROW_STREAM_HPP_INCLUDED__
+#define __CASS_ROW_STREAM_HPP_INCLUDED__
+
+#include "cassandra.h"
+#include "macros.hpp"
+#include "row.hpp"
+
+#include <stddef.h>
+#include <vector>
+
+namespace cass {
+
+class Metadata;
+class ResultResponse;
+
+// Decodes a RESULT body as it arrives. Rows are passed to the callback as
+// soon as they're complete and only the bytes of a partial row are kept.
+// The result keeps its metadata and paging state, but no rows. Bodies that
+// aren't rows are buffered and decoded once they're complete.
+class RowStream {
+public:
+  // The metadata is used when a result's metadata was skipped
+  RowStream(ResultResponse* result, Metadata* metadata,
+            CassRowCallback callback, void* data);
+
+  // Returns false if the body can't be decoded
+  bool append(int version, const char* input, size_t size);
+  bool finish(int version);
+
+private:
+  enum State {
+    STATE_HEADER,
+    STATE_ROWS,
+    STATE_BUFFERED
+  };
+
+  bool decode_header(int version);
+  bool decode_rows();
+
+private:
+  ResultResponse* result_;
+  Metadata* metadata_;
+  CassRowCallback callback_;
+  void* data_;
+  State state_;
+  std::vector<char> buffer_;
+  int32_t remaining_rows_;
+  Row row_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RowStream);
+};
+
+} // namespace cass
+
+#endif
@@ -0,0 +1,241 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "scanner.hpp"
+
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "scoped_mutex.hpp"
+#include "scoped_ptr.hpp"
+#include "types.hpp"
+
+#include "third_party/boost/boost/bind.hpp"
+
+#include <algorithm>
+#include <limits>
+
+extern "C" {
+
+CassFuture* cass_session_scan(CassSession* session,
+                              CassString query,
+                              CassString partition_key,
+                              cass_size_t split_count,
+                              cass_size_t concurrency,
+                              int page_size,
+                              CassRowCallback callback,
+                              void* data) {
+  cass::SharedRefPtr<cass::Scanner> scanner(
+        new cass::Scanner(session,
+                          std::string(query.data, query.length),
+                          std::string(partition_key.data, partition_key.length),
+                          split_count, concurrency, page_size,
+                          callback, data));
+  cass::Future* future = scanner->future();
+  future->inc_ref(); // External reference
+  scanner->start(session->tokens());
+  return CassFuture::to(future);
+}
+
+} // extern "C"
+
+namespace cass {
+
+Scanner::Scanner(RequestExecutor* executor,
+                 const std::string& query,
+                 const std::string& partition_key,
+                 size_t split_count,
+                 size_t concurrency,
+                 int32_t page_size,
+                 CassRowCallback callback,
+                 void* data)
+  : executor_(executor)
+  , query_(query)
+  , split_count_(split_count > 0 ? split_count : 1)
+  , concurrency_(concurrency > 0 ? concurrency : 1)
+  , page_size_(page_size)
+  , callback_(callback)
+  , data_(data)
+  , next_range_(0)
+  , in_flight_(0)
+  , error_code_(CASS_OK)
+  , future_(new ScanFuture()) {
+  uv_mutex_init(&mutex_);
+  query_.append(" WHERE token(");
+  query_.append(partition_key);
+  query_.append(") > ? AND token(");
+  query_.append(partition_key);
+  query_.append(") <= ?");
+}
+
+Scanner::~Scanner() {
+  uv_mutex_destroy(&mutex_);
+}
+
+void Scanner::start(const TokenMap& tokens) {
+  if (tokens.empty()) {
+    future_->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                       "The token ring isn't available, only "
+                       "Murmur3Partitioner is supported");
+    return;
+  }
+
+  std::vector<RequestPtr> requests;
+  {
+    ScopedMutex lock(&mutex_);
+    build_ranges(tokens, split_count_, &ranges_);
+    while (requests.size() < concurrency_) {
+      RequestPtr request(next_request());
+      if (!request) break;
+      requests.push_back(request);
+    }
+    // Counted before any are sent so a range that finishes inline can't
+    // finish the scan early
+    in_flight_ = requests.size();
+  }
+
+  if (requests.empty()) {
+    finish();
+    return;
+  }
+
+  for (std::vector<RequestPtr>::const_iterator it = requests.begin(),
+       end = requests.end(); it != end; ++it) {
+    fetch(*it);
+  }
+}
+
+// Splits (start, end] into "split_count" ranges of about the same width
+static void split_range(int64_t start, int64_t end, const Address& address,
+                        size_t split_count, Scanner::TokenRangeVec* ranges) {
+  // Unsigned arithmetic so the width of the range can't overflow
+  uint64_t width = static_cast<uint64_t>(end) - static_cast<uint64_t>(start);
+  uint64_t count = std::min<uint64_t>(split_count, width);
+  if (count == 0) return;
+  uint64_t step = width / count;
+
+  Scanner::TokenRange range;
+  range.address = address;
+  for (uint64_t i = 0; i < count; ++i) {
+    range.start = static_cast<int64_t>(static_cast<uint64_t>(start) + i * step);
+    range.end = i + 1 < count
+                ? static_cast<int64_t>(static_cast<uint64_t>(start) + (i + 1) * step)
+                : end;
+    ranges->push_back(range);
+  }
+}
+
+void Scanner::build_ranges(const TokenMap& tokens, size_t split_count,
+                           TokenRangeVec* ranges) {
+  if (tokens.empty()) return;
+
+  // The first token also owns the range that wraps around the ring:
+  // (last, max] and (min, first].
+  int64_t start = std::numeric_limits<int64_t>::min();
+  split_range(tokens.rbegin()->first, std::numeric_limits<int64_t>::max(),
+              tokens.begin()->second, split_count, ranges);
+
+  for (TokenMap::const_iterator it = tokens.begin(),
+       end = tokens.end(); it != end; ++it) {
+    split_range(start, it->first, it->second, split_count, ranges);
+    start = it->first;
+  }
+}
+
+Scanner::RequestPtr Scanner::next_request() {
+  if (next_range_ >= ranges_.size()) {
+    return RequestPtr();
+  }
+  const TokenRange& range = ranges_[next_range_++];
+
+  RequestPtr request(new QueryRequest(query_, 2));
+  request->bind(0, static_cast<cass_int64_t>(range.start));
+  request->bind(1, static_cast<cass_int64_t>(range.end));
+  if (page_size_ > 0) {
+    request->set_page_size(page_size_);
+  }
+  request->set_row_callback(callback_, data_);
+  request->set_preferred_address(range.address);
+  return request;
+}
+
+void Scanner::fetch(const RequestPtr& request) {
+  Future* future = NULL;
+  if (executor_->is_closing()) {
+    // The session can be gone by the time a request sent now would finish
+    future = new ResponseFuture();
+    future->inc_ref();
+    future->set_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "The session is closing");
+  } else {
+    future = executor_->execute_internal(request.get());
+  }
+  future->set_callback(boost::bind(&Scanner::on_page,
+                                   SharedRefPtr<Scanner>(this), request, _1),
+                       NULL);
+  future->dec_ref();
+}
+
+void Scanner::finish() {
+  if (error_code_ != CASS_OK) {
+    future_->set_error(error_code_, error_message_);
+  } else {
+    future_->set();
+  }
+}
+
+void Scanner::on_page(const SharedRefPtr<Scanner>& scanner,
+                      const RequestPtr& request,
+                      CassFuture* future) {
+  ResponseFuture* response_future = static_cast<ResponseFuture*>(future->from());
+
+  const Future::Error* error = response_future->get_error();
+  bool has_more_pages = false;
+  if (error == NULL) {
+    ScopedPtr<ResultResponse> result(
+          static_cast<ResultResponse*>(response_future->release_result()));
+    has_more_pages = result->has_more_pages();
+    if (has_more_pages) {
+      request->set_paging_state(result->paging_state());
+    }
+  }
+
+  RequestPtr next;
+  bool is_finished = false;
+  {
+    ScopedMutex lock(&scanner->mutex_);
+    if (error != NULL && scanner->error_code_ == CASS_OK) {
+      scanner->error_code_ = error->code;
+      scanner->error_message_ = error->message;
+    }
+
+    // The next page of the range is read before starting a new range and
+    // no new ranges are started after an error.
+    if (scanner->error_code_ == CASS_OK) {
+      next = has_more_pages ? request : scanner->next_request();
+    }
+
+    if (!next) {
+      is_finished = --scanner->in_flight_ == 0;
+    }
+  }
+
+  if (next) {
+    scanner->fetch(next);
+  } else if (is_finished) {
+    scanner->finish();
+  }
+}
+
+} // namespace cass
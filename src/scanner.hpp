@@ -0,0 +1,110 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_SCANNER_HPP_INCLUDED__
+#define __CASS_SCANNER_HPP_INCLUDED__
+
+#include "address.hpp"
+#include "cassandra.h"
+#include "future.hpp"
+#include "macros.hpp"
+#include "query_request.hpp"
+#include "ref_counted.hpp"
+#include "request_executor.hpp"
+#include "session.hpp"
+
+#include <uv.h>
+
+#include <string>
+#include <vector>
+
+namespace cass {
+
+class ScanFuture : public Future {
+public:
+  ScanFuture()
+      : Future(CASS_FUTURE_TYPE_SCAN) {}
+};
+
+// Reads a whole table by splitting the token ring into ranges and querying
+// them concurrently. Each range is sent to the host that owns it, which is
+// one of its replicas. Rows are passed to the row callback as they arrive
+// and the future is set when every range has been read.
+class Scanner : public RefCounted<Scanner> {
+public:
+  Scanner(RequestExecutor* executor,
+          const std::string& query,
+          const std::string& partition_key,
+          size_t split_count,
+          size_t concurrency,
+          int32_t page_size,
+          CassRowCallback callback,
+          void* data);
+  ~Scanner();
+
+  Future* future() { return future_.get(); }
+
+  // Reads the ranges owned by the hosts in "tokens"
+  void start(const TokenMap& tokens);
+
+  // A range of tokens, "start" is exclusive and "end" is inclusive
+  struct TokenRange {
+    int64_t start;
+    int64_t end;
+    Address address;
+  };
+
+  typedef std::vector<TokenRange> TokenRangeVec;
+
+  // Splits the ring into "split_count" ranges for each token. The range that
+  // wraps around the end of the ring is split in two.
+  static void build_ranges(const TokenMap& tokens, size_t split_count,
+                           TokenRangeVec* ranges);
+
+private:
+  typedef SharedRefPtr<QueryRequest> RequestPtr;
+
+  static void on_page(const SharedRefPtr<Scanner>& scanner,
+                      const RequestPtr& request,
+                      CassFuture* future);
+
+  RequestPtr next_request();
+  void fetch(const RequestPtr& request);
+  void finish();
+
+private:
+  uv_mutex_t mutex_;
+  RequestExecutor* executor_;
+  std::string query_;
+  size_t split_count_;
+  size_t concurrency_;
+  int32_t page_size_;
+  CassRowCallback callback_;
+  void* data_;
+  TokenRangeVec ranges_;
+  size_t next_range_;
+  size_t in_flight_;
+  CassError error_code_;
+  std::string error_message_;
+  SharedRefPtr<ScanFuture> future_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(Scanner);
+};
+
+} // namespace cass
+
+#endif
@@ -0,0 +1,227 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "scatter_gather.hpp"
+
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "scoped_mutex.hpp"
+#include "serialization.hpp"
+#include "types.hpp"
+
+#include "third_party/boost/boost/bind.hpp"
+
+extern "C" {
+
+CassFuture* cass_session_execute_scatter(CassSession* session,
+                                         const CassStatement* statement,
+                                         cass_size_t key_index,
+                                         const CassCollection* keys,
+                                         cass_size_t concurrency,
+                                         cass_bool_t preserve_order) {
+  if (statement->kind() != CASS_BATCH_KIND_PREPARED || keys->is_map()) {
+    cass::ScatterFuture* future = new cass::ScatterFuture(0);
+    future->inc_ref(); // External reference
+    future->set_error(CASS_ERROR_LIB_BAD_PARAMS,
+                      "Only a prepared statement and a list or set of keys "
+                      "can be scattered");
+    return CassFuture::to(future);
+  }
+
+  cass::SharedRefPtr<cass::ScatterGather> scatter(
+        new cass::ScatterGather(session,
+                                static_cast<const cass::ExecuteRequest*>(statement->from()),
+                                key_index, keys, concurrency,
+                                preserve_order == cass_true));
+  cass::Future* future = scatter->future();
+  future->inc_ref(); // External reference
+  scatter->start();
+  return CassFuture::to(future);
+}
+
+CassIterator* cass_iterator_from_future(CassFuture* future) {
+  if (future->type() != cass::CASS_FUTURE_TYPE_SCATTER ||
+      future->is_error()) {
+    return NULL;
+  }
+  return CassIterator::to(
+        new cass::MultipleResultIterator(
+          static_cast<cass::ScatterFuture*>(future->from())));
+}
+
+} // extern "C"
+
+namespace cass {
+
+ScatterFuture::~ScatterFuture() {
+  for (ResultVec::iterator it = results_.begin(),
+       end = results_.end(); it != end; ++it) {
+    delete *it;
+  }
+}
+
+ScatterGather::ScatterGather(RequestExecutor* executor,
+                             const ExecuteRequest* statement,
+                             size_t key_index,
+                             const BufferCollection* keys,
+                             size_t concurrency,
+                             bool preserve_order)
+  : executor_(executor)
+  , statement_(statement)
+  , key_index_(key_index)
+  , keys_(keys->data(), keys->data() + keys->data_size())
+  , key_count_(keys->item_count())
+  , next_key_pos_(0)
+  , next_index_(0)
+  , concurrency_(concurrency > 0 ? concurrency : 1)
+  , preserve_order_(preserve_order)
+  , result_count_(0)
+  , in_flight_(0)
+  , error_code_(CASS_OK)
+  , future_(new ScatterFuture(key_count_)) {
+  uv_mutex_init(&mutex_);
+}
+
+ScatterGather::~ScatterGather() {
+  uv_mutex_destroy(&mutex_);
+}
+
+void ScatterGather::start() {
+  std::vector<std::pair<RequestPtr, size_t> > requests;
+  {
+    ScopedMutex lock(&mutex_);
+    while (requests.size() < concurrency_) {
+      RequestPtr request;
+      size_t index;
+      error_code_ = next_request(&request, &index);
+      if (!request) break;
+      requests.push_back(std::make_pair(request, index));
+    }
+    // Counted before any are sent so a request that finishes inline
+    // can't finish the others early
+    in_flight_ = requests.size();
+  }
+
+  if (requests.empty()) {
+    finish();
+    return;
+  }
+
+  for (std::vector<std::pair<RequestPtr, size_t> >::const_iterator it = requests.begin(),
+       end = requests.end(); it != end; ++it) {
+    fetch(it->first, it->second);
+  }
+}
+
+CassError ScatterGather::next_request(RequestPtr* request, size_t* index) {
+  if (next_index_ >= key_count_) {
+    return CASS_OK;
+  }
+
+  uint16_t size;
+  const char* key = decode_uint16(&keys_[next_key_pos_], size);
+  next_key_pos_ = (key - &keys_[0]) + size;
+
+  RequestPtr temp(new ExecuteRequest(statement_->prepared().get()));
+  temp->copy_values_and_settings(*statement_);
+  CassError rc = temp->bind(key_index_, cass_bytes_init(reinterpret_cast<const cass_byte_t*>(key), size));
+  if (rc != CASS_OK) {
+    error_message_ = "Unable to bind the key";
+    return rc;
+  }
+
+  *request = temp;
+  *index = next_index_++;
+  return CASS_OK;
+}
+
+void ScatterGather::fetch(const RequestPtr& request, size_t index) {
+  Future* future = NULL;
+  if (executor_->is_closing()) {
+    // The session can be gone by the time a request sent now would finish
+    future = new ResponseFuture();
+    future->inc_ref();
+    future->set_error(CASS_ERROR_LIB_REQUEST_CANCELLED,
+                      "The session is closing");
+  } else {
+    future = executor_->execute_internal(request.get());
+  }
+  // The next request is executed from the callback so execute_internal()
+  // keeps it off the IO thread, even in the inline callback mode
+  future->set_callback(boost::bind(&ScatterGather::on_result,
+                                   SharedRefPtr<ScatterGather>(this), index, _1),
+                       NULL);
+  future->dec_ref();
+}
+
+void ScatterGather::finish() {
+  if (error_code_ != CASS_OK) {
+    future_->set_error(error_code_, error_message_);
+  } else {
+    future_->set();
+  }
+}
+
+void ScatterGather::on_result(const SharedRefPtr<ScatterGather>& scatter,
+                              size_t index,
+                              CassFuture* future) {
+  ResponseFuture* response_future = static_cast<ResponseFuture*>(future->from());
+
+  const Future::Error* error = response_future->get_error();
+  ScopedPtr<ResultResponse> result;
+  if (error == NULL) {
+    result.reset(static_cast<ResultResponse*>(response_future->release_result()));
+    if (result->kind() == CASS_RESULT_KIND_ROWS) {
+      result->decode_first_row();
+    } else {
+      result.reset();
+    }
+  }
+
+  RequestPtr next;
+  size_t next_index = 0;
+  bool is_finished = false;
+  {
+    ScopedMutex lock(&scatter->mutex_);
+    if (error != NULL && scatter->error_code_ == CASS_OK) {
+      scatter->error_code_ = error->code;
+      scatter->error_message_ = error->message;
+    }
+
+    if (result) {
+      size_t slot = scatter->preserve_order_ ? index : scatter->result_count_;
+      scatter->future_->set_result(slot, result.release());
+      ++scatter->result_count_;
+    }
+
+    // No new requests are sent after an error
+    if (scatter->error_code_ == CASS_OK) {
+      scatter->error_code_ = scatter->next_request(&next, &next_index);
+    }
+
+    if (!next) {
+      is_finished = --scatter->in_flight_ == 0;
+    }
+  }
+
+  if (next) {
+    scatter->fetch(next, next_index);
+  } else if (is_finished) {
+    scatter->finish();
+  }
+}
+
+} // namespace cass
@@ -0,0 +1,145 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_SCATTER_GATHER_HPP_INCLUDED__
+#define __CASS_SCATTER_GATHER_HPP_INCLUDED__
+
+#include "buffer_collection.hpp"
+#include "cassandra.h"
+#include "execute_request.hpp"
+#include "future.hpp"
+#include "iterator.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "request_executor.hpp"
+#include "result_iterator.hpp"
+#include "scoped_ptr.hpp"
+
+#include <uv.h>
+
+#include <string>
+#include <vector>
+
+namespace cass {
+
+class ResultResponse;
+
+class ScatterFuture : public Future {
+public:
+  typedef std::vector<ResultResponse*> ResultVec;
+
+  ScatterFuture(size_t result_count)
+      : Future(CASS_FUTURE_TYPE_SCATTER)
+      , results_(result_count, NULL) {}
+
+  ~ScatterFuture();
+
+  // Only valid after the future is set
+  const ResultVec& results() const { return results_; }
+
+  void set_result(size_t index, ResultResponse* result) {
+    results_[index] = result;
+  }
+
+private:
+  ResultVec results_;
+};
+
+// Executes a prepared single partition statement once for each key and
+// gathers the results. The next request is sent from the callback of the
+// previous one so at most "concurrency" are in-flight at a time. The keys
+// are copied so the collection can be changed or freed once started.
+class ScatterGather : public RefCounted<ScatterGather> {
+public:
+  ScatterGather(RequestExecutor* executor,
+                const ExecuteRequest* statement,
+                size_t key_index,
+                const BufferCollection* keys,
+                size_t concurrency,
+                bool preserve_order);
+  ~ScatterGather();
+
+  Future* future() { return future_.get(); }
+
+  void start();
+
+private:
+  typedef SharedRefPtr<ExecuteRequest> RequestPtr;
+
+  static void on_result(const SharedRefPtr<ScatterGather>& scatter,
+                        size_t index,
+                        CassFuture* future);
+
+  CassError next_request(RequestPtr* request, size_t* index);
+  void fetch(const RequestPtr& request, size_t index);
+  void finish();
+
+private:
+  uv_mutex_t mutex_;
+  RequestExecutor* executor_;
+  SharedRefPtr<const ExecuteRequest> statement_;
+  size_t key_index_;
+  std::vector<char> keys_;
+  size_t key_count_;
+  size_t next_key_pos_;
+  size_t next_index_;
+  size_t concurrency_;
+  bool preserve_order_;
+  size_t result_count_;
+  size_t in_flight_;
+  CassError error_code_;
+  std::string error_message_;
+  SharedRefPtr<ScatterFuture> future_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ScatterGather);
+};
+
+// Iterates over the rows of all the results gathered by a scatter future
+class MultipleResultIterator : public Iterator {
+public:
+  MultipleResultIterator(ScatterFuture* future)
+      : Iterator(CASS_ITERATOR_TYPE_MULTIPLE_RESULT)
+      , future_(future)
+      , index_(0) {}
+
+  virtual bool next() {
+    const ScatterFuture::ResultVec& results = future_->results();
+    while (!iterator_ || !iterator_->next()) {
+      if (index_ >= results.size()) {
+        return false;
+      }
+      const ResultResponse* result = results[index_++];
+      if (result != NULL) {
+        iterator_.reset(new ResultIterator(result));
+      }
+    }
+    return true;
+  }
+
+  const Row* row() const {
+    return iterator_->row();
+  }
+
+private:
+  SharedRefPtr<ScatterFuture> future_;
+  ScopedPtr<ResultIterator> iterator_;
+  size_t index_;
+};
+
+} // namespace cass
+
+#endif
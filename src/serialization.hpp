@@ -27,6 +27,7 @@
 #include "third_party/boost/boost/utility/string_ref.hpp"
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 #include <list>
 #include <map>
@@ -51,9 +52,10 @@ inline char* decode_byte(char* input, uint8_t& output) {
   return input + sizeof(uint8_t);
 }
 
-inline void encode_uint16(char* output, uint16_t value) {
+inline char* encode_uint16(char* output, uint16_t value) {
   output[0] = static_cast<char>(value >> 8);
   output[1] = static_cast<char>(value >> 0);
+  return output + sizeof(uint16_t);
 }
 
 inline char* decode_uint16(char* input, uint16_t& output) {
@@ -62,11 +64,12 @@ inline char* decode_uint16(char* input, uint16_t& output) {
   return input + sizeof(uint16_t);
 }
 
-inline void encode_int32(char* output, int32_t value) {
+inline char* encode_int32(char* output, int32_t value) {
   output[0] = static_cast<char>(value >> 24);
   output[1] = static_cast<char>(value >> 16);
   output[2] = static_cast<char>(value >> 8);
   output[3] = static_cast<char>(value >> 0);
+  return output + sizeof(int32_t);
 }
 
 inline char* decode_int32(char* input, int32_t& output) {
@@ -122,6 +125,90 @@ inline char* decode_double(char* input, double& output) {
   return decode_int64(input, *copy_cast<double*, cass_int64_t*>(&output));
 }
 
+inline char* encode_string(char* output, const char* value, uint16_t size) {
+  char* pos = encode_uint16(output, size);
+  memcpy(pos, value, size);
+  return pos + size;
+}
+
+inline char* encode_long_string(char* output, const char* value, int32_t size) {
+  char* pos = encode_int32(output, size);
+  memcpy(pos, value, size);
+  return pos + size;
+}
+
+// Run kernels: these decode "count" fixed width values that are "stride"
+// bytes apart, e.g. the elements of a collection. Values in the protocol are
+// interleaved with their sizes, so there are no contiguous runs to vectorize.
+// Instead, each value is loaded in one move and byte swapped by a single
+// instruction on little endian platforms. Other platforms fall back to the
+// shifts used to decode a single value.
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CASS_BYTE_SWAP_32(x) __builtin_bswap32(x)
+#define CASS_BYTE_SWAP_64(x) __builtin_bswap64(x)
+#elif defined(_MSC_VER)
+#define CASS_BYTE_SWAP_32(x) _byteswap_ulong(x)
+#define CASS_BYTE_SWAP_64(x) _byteswap_uint64(x)
+#endif
+
+inline uint32_t load_uint32(const char* input) {
+#if defined(CASS_BYTE_SWAP_32)
+  uint32_t value;
+  memcpy(&value, input, sizeof(uint32_t));
+  return CASS_BYTE_SWAP_32(value);
+#else
+  int32_t value;
+  decode_int32(const_cast<char*>(input), value);
+  return static_cast<uint32_t>(value);
+#endif
+}
+
+inline uint64_t load_uint64(const char* input) {
+#if defined(CASS_BYTE_SWAP_64)
+  uint64_t value;
+  memcpy(&value, input, sizeof(uint64_t));
+  return CASS_BYTE_SWAP_64(value);
+#else
+  cass_int64_t value;
+  decode_int64(const_cast<char*>(input), value);
+  return static_cast<uint64_t>(value);
+#endif
+}
+
+inline void decode_int32_run(const char* input, size_t stride, size_t count,
+                             int32_t* output) {
+  for (size_t i = 0; i < count; ++i, input += stride) {
+    output[i] = static_cast<int32_t>(load_uint32(input));
+  }
+}
+
+inline void decode_int64_run(const char* input, size_t stride, size_t count,
+                             cass_int64_t* output) {
+  for (size_t i = 0; i < count; ++i, input += stride) {
+    output[i] = static_cast<cass_int64_t>(load_uint64(input));
+  }
+}
+
+inline void decode_float_run(const char* input, size_t stride, size_t count,
+                             float* output) {
+  BOOST_STATIC_ASSERT(std::numeric_limits<float>::is_iec559);
+  for (size_t i = 0; i < count; ++i, input += stride) {
+    uint32_t value = load_uint32(input);
+    memcpy(&output[i], &value, sizeof(float));
+  }
+}
+
+inline void decode_double_run(const char* input, size_t stride, size_t count,
+                              double* output) {
+  BOOST_STATIC_ASSERT(std::numeric_limits<double>::is_iec559);
+  for (size_t i = 0; i < count; ++i, input += stride) {
+    uint64_t value = load_uint64(input);
+    memcpy(&output[i], &value, sizeof(double));
+  }
+}
+
 inline char* decode_string(char* input, char** output, size_t& size) {
   uint16_t string_size;
   char* pos = decode_uint16(input, string_size);
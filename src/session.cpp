@@ -17,6 +17,7 @@
 #include "session.hpp"
 
 #include "config.hpp"
+#include "get_time.hpp"
 #include "prepare_request.hpp"
 #include "request_handler.hpp"
 #include "resolver.hpp"
@@ -26,6 +27,8 @@
 
 #include "third_party/boost/boost/bind.hpp"
 
+#include <algorithm>
+
 extern "C" {
 
 CassFuture* cass_session_close(CassSession* session) {
@@ -42,29 +45,104 @@ CassFuture* cass_session_prepare(CassSession* session, CassString query) {
 
 CassFuture* cass_session_execute(CassSession* session,
                                  const CassStatement* statement) {
-  return CassFuture::to(session->execute(statement->from()));
+  uint64_t block_delay = 0;
+  cass::Future* future = session->execute(statement->from(), &block_delay);
+  if (block_delay > 0) {
+    // Only the application's thread is blocked by the rate limit
+    cass::sleep_for_microseconds(block_delay);
+  }
+  return CassFuture::to(future);
 }
 
 CassFuture* cass_session_execute_batch(CassSession* session, const CassBatch* batch) {
-  return CassFuture::to(session->execute(batch->from()));
+  uint64_t block_delay = 0;
+  cass::Future* future = session->execute(batch->from(), &block_delay);
+  if (block_delay > 0) {
+    // Only the application's thread is blocked by the rate limit
+    cass::sleep_for_microseconds(block_delay);
+  }
+  return CassFuture::to(future);
+}
+
+CassError cass_session_get_concurrency_limit(CassSession* session,
+                                             const char* address,
+                                             unsigned* limit) {
+  cass::Address host_address;
+  if (!cass::Address::from_string(address, session->config().port(),
+                                  &host_address)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  *limit = session->concurrency_limit(host_address);
+  return CASS_OK;
 }
 
 } // extern "C"
 
 namespace cass {
 
+// Tries the request's preferred host first and then the hosts from the
+// load balancing policy's plan
+class PreferredHostQueryPlan : public QueryPlan {
+public:
+  PreferredHostQueryPlan(const SharedRefPtr<Host>& host, QueryPlan* child_plan)
+    : host_(host)
+    , child_plan_(child_plan)
+    , is_host_tried_(false) {}
+
+  virtual bool compute_next(Address* address) {
+    if (!is_host_tried_) {
+      is_host_tried_ = true;
+      if (host_->is_up()) {
+        *address = host_->address();
+        return true;
+      }
+    }
+    while (child_plan_->compute_next(address)) {
+      if (address->compare(host_->address()) != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  SharedRefPtr<Host> host_;
+  ScopedPtr<QueryPlan> child_plan_;
+  bool is_host_tried_;
+};
+
 Session::Session(const Config& config)
     : close_future_(NULL)
+    , is_closing_(false)
     , current_host_mark_(true)
     , config_(config)
     , load_balancing_policy_(config.load_balancing_policy())
+    , prepared_cache_(new PreparedCache(config.prepared_cache_size()))
     , pending_resolve_count_(0)
     , pending_pool_count_(0)
     , pending_workers_count_(0)
-    , current_io_worker_(0) {}
+    , current_io_worker_(0) {
+  if (config_.rate_limit().rate > 0.0) {
+    rate_limiter_.reset(new RateLimiter(config_.rate_limit()));
+  }
+  for (RateLimitSettingsMap::const_iterator it = config_.rate_limit_classes().begin(),
+       end = config_.rate_limit_classes().end(); it != end; ++it) {
+    rate_limiters_[it->first] = SharedRefPtr<RateLimiter>(new RateLimiter(it->second));
+  }
+  uv_mutex_init(&tokens_mutex_);
+  uv_mutex_init(&keyspace_mutex_);
+}
+
+Session::~Session() {
+  uv_mutex_destroy(&tokens_mutex_);
+  uv_mutex_destroy(&keyspace_mutex_);
+}
 
 int Session::init() {
-  int rc = EventThread<SessionEvent>::init(config_.queue_size_event());
+  logger_.reset(new Logger(config_));
+  int rc = logger_->init();
+  if (rc != 0) return rc;
+  rc = EventThread<SessionEvent>::init(config_.queue_size_event());
   if (rc != 0) return rc;
   request_queue_.reset(
       new AsyncQueue<MPMCQueue<RequestHandler*> >(config_.queue_size_io()));
@@ -84,6 +162,10 @@ void Session::broadcast_keyspace_change(const std::string& keyspace,
   // This can run on an IO worker thread. This is thread-safe because the IO workers
   // vector never changes after initialization and IOWorker::set_keyspace() uses a mutex.
   // This also means that calling "USE <keyspace>" frequently is an anti-pattern.
+  {
+    ScopedMutex lock(&keyspace_mutex_);
+    keyspace_ = keyspace;
+  }
   for (IOWorkerVec::iterator it = io_workers_.begin(),
        end = io_workers_.end(); it != end; ++it) {
     if (*it == calling_io_worker) continue;
@@ -91,6 +173,11 @@ void Session::broadcast_keyspace_change(const std::string& keyspace,
   }
 }
 
+std::string Session::keyspace() const {
+  ScopedMutex lock(&keyspace_mutex_);
+  return keyspace_;
+}
+
 SharedRefPtr<Host> Session::get_host(const Address& address, bool should_mark) {
   HostMap::iterator it = hosts_.find(address);
   if (it == hosts_.end()) {
@@ -162,8 +249,7 @@ bool Session::notify_down_async(const Address& address, bool is_critical_failure
 }
 
 bool Session::connect_async(const std::string& keyspace, Future* future) {
-  logger_.reset(new Logger(config_));
-  if (logger_->init() != 0 || init() != 0) {
+  if (init() != 0) {
     return false;
   }
 
@@ -187,6 +273,7 @@ bool Session::connect_async(const std::string& keyspace, Future* future) {
 void Session::close_async(Future* future) {
   assert(future != NULL);
   close_future_ = future;
+  is_closing_.store(true);
   while (!request_queue_->enqueue(NULL)) {
     // Keep trying
   }
@@ -296,7 +383,115 @@ void Session::on_resolve(Resolver* resolver) {
   }
 }
 
-void Session::execute(RequestHandler* request_handler) {
+unsigned Session::concurrency_limit(const Address& address) const {
+  unsigned limit = 0;
+  for (IOWorkerVec::const_iterator it = io_workers_.begin(),
+       end = io_workers_.end(); it != end; ++it) {
+    limit += (*it)->concurrency_limit(address);
+  }
+  return limit;
+}
+
+void Session::update_tokens(const Address& address, const TokenVec& tokens) {
+  ScopedMutex lock(&tokens_mutex_);
+  TokenMap::iterator it = tokens_.begin();
+  while (it != tokens_.end()) {
+    if (it->second.compare(address) == 0) {
+      tokens_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  for (TokenVec::const_iterator it = tokens.begin(),
+       end = tokens.end(); it != end; ++it) {
+    tokens_[*it] = address;
+  }
+}
+
+TokenMap Session::tokens() const {
+  ScopedMutex lock(&tokens_mutex_);
+  return tokens_;
+}
+
+static bool acquire_permit(RateLimiter* rate_limiter, uint64_t now,
+                           uint64_t max_delay, uint64_t* delay,
+                           bool* is_blocking) {
+  uint64_t permit_delay = 0;
+  if (!rate_limiter->acquire(now, max_delay, &permit_delay)) {
+    return false;
+  }
+  if (permit_delay > 0) {
+    *delay = std::max(*delay, permit_delay);
+    if (rate_limiter->mode() == CASS_RATE_LIMIT_MODE_BLOCK) {
+      *is_blocking = true;
+    }
+  }
+  return true;
+}
+
+bool Session::acquire_rate_limit_permits(RequestHandler* request_handler,
+                                         uint64_t request_timeout,
+                                         uint64_t* block_delay) {
+  if (!rate_limiter_ && rate_limiters_.empty()) {
+    return true;
+  }
+
+  uint64_t now = uv_hrtime() / 1000; // Microseconds
+  uint64_t delay = 0;
+  bool is_blocking = false;
+
+  // A request held back past its timeout would only time out, so that's as
+  // far ahead as permits are reserved.
+  uint64_t max_delay = request_timeout * 1000;
+
+  RateLimiter* class_rate_limiter = NULL;
+  unsigned request_class = request_handler->request()->request_class();
+  if (request_class != 0) {
+    RateLimiterMap::iterator it = rate_limiters_.find(request_class);
+    if (it != rate_limiters_.end()) {
+      class_rate_limiter = it->second.get();
+      if (!acquire_permit(class_rate_limiter, now, max_delay,
+                          &delay, &is_blocking)) {
+        return false;
+      }
+    }
+  }
+
+  if (rate_limiter_ &&
+      !acquire_permit(rate_limiter_.get(), now, max_delay,
+                      &delay, &is_blocking)) {
+    if (class_rate_limiter != NULL) {
+      class_rate_limiter->release();
+    }
+    return false;
+  }
+
+  if (delay > 0) {
+    // The IO worker holds the request until it's allowed to be sent
+    request_handler->set_dispatch_time(now + delay);
+    if (is_blocking && block_delay != NULL) {
+      *block_delay = delay;
+    }
+  }
+
+  return true;
+}
+
+void Session::execute(RequestHandler* request_handler, uint64_t* block_delay) {
+  unsigned request_timeout = request_handler->request()->request_timeout();
+  if (request_timeout == 0) {
+    request_timeout = config_.request_timeout();
+  }
+  request_handler->set_deadline(get_monotonic_time_ms() + request_timeout);
+
+  if (!acquire_rate_limit_permits(request_handler, request_timeout,
+                                  block_delay)) {
+    request_handler->on_error(CASS_ERROR_LIB_RATE_LIMITED,
+                              "Rate limit exceeded");
+    request_handler->dec_ref();
+    return;
+  }
+
   if (!request_queue_->enqueue(request_handler)) {
     request_handler->on_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
                               "The request queue has reached capacity");
@@ -310,6 +505,14 @@ void Session::on_control_connection_ready() {
        end = io_workers_.end(); it != end; ++it) {
     (*it)->set_protocol_version(control_connection_.protocol_version());
   }
+  if (!config_.prepared_cache_file().empty()) {
+    size_t count = prepared_cache_->load(config_.prepared_cache_file(),
+                                         control_connection_.protocol_version(),
+                                         &prepared_registry_);
+    logger_->info("Session: Loaded %u prepared statements from '%s'",
+                  static_cast<unsigned>(count),
+                  config_.prepared_cache_file().c_str());
+  }
   pending_pool_count_ = hosts_.size() * io_workers_.size();
   for (HostMap::iterator it = hosts_.begin(), hosts_end = hosts_.end();
        it != hosts_end; ++it) {
@@ -323,14 +526,23 @@ void Session::on_control_connection_error(CassError code, const std::string& mes
 }
 
 Future* Session::prepare(const char* statement, size_t length) {
-  PrepareRequest* prepare = new PrepareRequest();
-  prepare->set_query(statement, length);
-
   ResponseFuture* future = new ResponseFuture();
   future->inc_ref(); // External reference
   future->statement.assign(statement, length);
 
-  RequestHandler* request_handler = new RequestHandler(prepare, future);
+  // The statement is cached under the keyspace it's prepared in, even if
+  // the session's keyspace changes before the PREPARE request is sent.
+  std::string keyspace = this->keyspace();
+  ResponseFuture* request_future = prepared_cache_->add(keyspace, future);
+  if (request_future == NULL) {
+    return future; // Already cached or being prepared
+  }
+
+  PrepareRequest* prepare = new PrepareRequest();
+  prepare->set_query(statement, length);
+  prepare->set_keyspace(keyspace);
+
+  RequestHandler* request_handler = new RequestHandler(prepare, request_future);
   request_handler->inc_ref(); // IOWorker reference
 
   execute(request_handler);
@@ -356,6 +568,7 @@ void Session::on_add(SharedRefPtr<Host> host, bool is_initial_connection) {
 
 void Session::on_remove(SharedRefPtr<Host> host) {
   load_balancing_policy_->on_remove(host);
+  update_tokens(host->address(), TokenVec());
 
   hosts_.erase(host->address());
   for (IOWorkerVec::iterator it = io_workers_.begin(),
@@ -398,9 +611,27 @@ void Session::on_down(SharedRefPtr<Host> host, bool is_critical_failure) {
   }
 }
 
-Future* Session::execute(const Request* statement) {
+void Session::on_schema_change(const std::string& keyspace,
+                               const std::string& table) {
+  prepared_cache_->invalidate(keyspace, table);
+}
+
+Future* Session::execute(const Request* statement, uint64_t* block_delay) {
+  ResponseFuture* future = new ResponseFuture();
+  future->inc_ref(); // External reference
+
+  RequestHandler* request_handler = new RequestHandler(statement, future);
+  request_handler->inc_ref(); // IOWorker reference
+
+  execute(request_handler, block_delay);
+
+  return future;
+}
+
+Future* Session::execute_internal(const Request* statement) {
   ResponseFuture* future = new ResponseFuture();
   future->inc_ref(); // External reference
+  future->set_internal();
 
   RequestHandler* request_handler = new RequestHandler(statement, future);
   request_handler->inc_ref(); // IOWorker reference
@@ -418,7 +649,15 @@ void Session::on_execute(uv_async_t* data, int status) {
   RequestHandler* request_handler = NULL;
   while (session->request_queue_->dequeue(request_handler)) {
     if (request_handler != NULL) {
-      request_handler->set_query_plan(session->load_balancing_policy_->new_query_plan());
+      QueryPlan* query_plan = session->load_balancing_policy_->new_query_plan();
+      const Request* request = request_handler->request();
+      if (request->has_preferred_address()) {
+        SharedRefPtr<Host> host = session->get_host(request->preferred_address());
+        if (host) {
+          query_plan = new PreferredHostQueryPlan(host, query_plan);
+        }
+      }
+      request_handler->set_query_plan(query_plan);
 
       size_t start = session->current_io_worker_;
       size_t remaining = session->io_workers_.size();
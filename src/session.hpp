@@ -26,12 +26,19 @@
 #include "load_balancing.hpp"
 #include "logger.hpp"
 #include "mpmc_queue.hpp"
+#include "prepared_cache.hpp"
+#include "prepared_registry.hpp"
+#include "rate_limiter.hpp"
 #include "ref_counted.hpp"
+#include "request_executor.hpp"
 #include "scoped_mutex.hpp"
 #include "scoped_ptr.hpp"
 #include "spsc_queue.hpp"
 
+#include "third_party/boost/boost/atomic.hpp"
+
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -47,6 +54,10 @@ class IOWorker;
 class Resolver;
 class Request;
 
+// Murmur3 tokens mapped to the host that owns the range ending at the token
+typedef std::map<int64_t, Address> TokenMap;
+typedef std::vector<int64_t> TokenVec;
+
 struct SessionEvent {
   enum Type {
     CONNECT,
@@ -60,9 +71,10 @@ struct SessionEvent {
   bool is_critical_failure;
 };
 
-class Session : public EventThread<SessionEvent> {
+class Session : public EventThread<SessionEvent>, public RequestExecutor {
 public:
   Session(const Config& config);
+  ~Session();
 
   int init();
 
@@ -89,14 +101,37 @@ public:
   void close_async(Future* future);
 
   Future* prepare(const char* statement, size_t length);
-  Future* execute(const Request* statement);
+  // Rate limiters in the blocking mode never block here. The time the
+  // calling application thread should block is returned in "block_delay"
+  // (microseconds) and is ignored by callers on the driver's own threads.
+  Future* execute(const Request* statement, uint64_t* block_delay = NULL);
+  virtual Future* execute_internal(const Request* statement);
+
+  // Set as soon as the session starts closing
+  virtual bool is_closing() const { return is_closing_.load(); }
+
+  unsigned concurrency_limit(const Address& address) const;
+
+  // The token ring is updated on the session's thread using the control
+  // connection and can be copied from any thread.
+  void update_tokens(const Address& address, const TokenVec& tokens);
+  TokenMap tokens() const;
+
+  PreparedRegistry* prepared_registry() { return &prepared_registry_; }
+
+  // The keyspace of the last "USE <keyspace>" query or the one given when
+  // connecting. Not returned by reference because it can change at any time.
+  std::string keyspace() const;
 
 private:
   void close_handles();
 
   void internal_connect();
 
-  void execute(RequestHandler* request_handler);
+  void execute(RequestHandler* request_handler, uint64_t* block_delay = NULL);
+  bool acquire_rate_limit_permits(RequestHandler* request_handler,
+                                  uint64_t request_timeout,
+                                  uint64_t* block_delay);
 
   virtual void on_run();
   virtual void on_after_run();
@@ -117,24 +152,35 @@ private:
   void on_remove(SharedRefPtr<Host> host);
   void on_up(SharedRefPtr<Host> host);
   void on_down(SharedRefPtr<Host> host, bool is_critical_failure);
+  void on_schema_change(const std::string& keyspace, const std::string& table);
 
 private:
   typedef std::vector<SharedRefPtr<IOWorker> > IOWorkerVec;
+  typedef std::map<unsigned, SharedRefPtr<RateLimiter> > RateLimiterMap;
 
   ControlConnection control_connection_;
   IOWorkerVec io_workers_;
   ScopedPtr<Logger> logger_;
   ScopedRefPtr<Future> connect_future_;
   Future* close_future_;
+  boost::atomic<bool> is_closing_;
   HostMap hosts_;
   bool current_host_mark_;
   Config config_;
   ScopedPtr<AsyncQueue<MPMCQueue<RequestHandler*> > > request_queue_;
   ScopedRefPtr<LoadBalancingPolicy> load_balancing_policy_;
+  SharedRefPtr<RateLimiter> rate_limiter_;
+  RateLimiterMap rate_limiters_;
+  PreparedRegistry prepared_registry_;
+  SharedRefPtr<PreparedCache> prepared_cache_;
   int pending_resolve_count_;
   int pending_pool_count_;
   int pending_workers_count_;
   int current_io_worker_;
+  mutable uv_mutex_t tokens_mutex_;
+  TokenMap tokens_;
+  mutable uv_mutex_t keyspace_mutex_;
+  std::string keyspace_;
 };
 
 class SessionCloseFuture : public Future {
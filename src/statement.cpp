@@ -90,6 +90,20 @@ namespace {
     }
   };
 
+  template<>
+  struct IsValidValueType<CassStringRef> {
+    bool operator()(uint16_t type) const {
+      return IsValidValueType<CassString>()(type);
+    }
+  };
+
+  template<>
+  struct IsValidValueType<CassBytesRef> {
+    bool operator()(uint16_t type) const {
+      return IsValidValueType<CassBytes>()(type);
+    }
+  };
+
   template<>
   struct IsValidValueType<const CassUuid> {
     bool operator()(uint16_t type) const {
@@ -160,6 +174,40 @@ namespace {
     return CASS_OK;
   }
 
+  template<class T>
+  CassError bind_by_handle(cass::Statement* statement,
+                           CassColumnHandle handle,
+                           T value) {
+    if (statement->opcode() != CQL_OPCODE_EXECUTE) {
+      return CASS_ERROR_INVALID_STATEMENT_TYPE;
+    }
+
+    const cass::Metadata* metadata
+        = static_cast<cass::ExecuteRequest*>(statement)->prepared()->result()->metadata().get();
+
+    if (!metadata->is_valid_handle(handle)) {
+      return CASS_ERROR_LIB_INVALID_COLUMN_HANDLE;
+    }
+
+    const cass::ColumnDefinition* first
+        = static_cast<const cass::ColumnDefinition*>(handle.column);
+    boost::string_ref name(first->name, first->name_size);
+    IsValidValueType<T> is_valid_type;
+
+    for (const cass::ColumnDefinition* def = first; def != NULL; def = def->next) {
+      if (handle.is_case_sensitive &&
+          name.compare(boost::string_ref(def->name, def->name_size)) != 0) {
+        continue;
+      }
+      if (!is_valid_type(def->type)) {
+        return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+      }
+      statement->bind(def->index, value);
+    }
+
+    return CASS_OK;
+  }
+
 } // namespace
 
 extern "C" {
@@ -175,6 +223,14 @@ void cass_statement_free(CassStatement* statement) {
   statement->dec_ref();
 }
 
+void cass_statement_reset(CassStatement* statement) {
+  statement->reset();
+}
+
+void cass_statement_freeze(CassStatement* statement) {
+  statement->freeze();
+}
+
 CassError cass_statement_set_consistency(CassStatement* statement,
                                          CassConsistency consistency) {
   statement->set_consistency(consistency);
@@ -193,9 +249,40 @@ CassError cass_statement_set_paging_size(CassStatement* statement,
   return CASS_OK;
 }
 
+CassError cass_statement_set_paging_size_bytes(CassStatement* statement,
+                                               cass_size_t page_size_bytes,
+                                               int min_page_size,
+                                               int max_page_size) {
+  if (min_page_size <= 0 || min_page_size > max_page_size) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  statement->set_page_size_bytes(page_size_bytes, min_page_size, max_page_size);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_request_timeout(CassStatement* statement,
+                                             unsigned timeout) {
+  statement->set_request_timeout(timeout);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_row_callback(CassStatement* statement,
+                                          CassRowCallback callback,
+                                          void* data) {
+  statement->set_row_callback(callback, data);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_request_class(CassStatement* statement,
+                                           unsigned request_class) {
+  statement->set_request_class(request_class);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_paging_state(CassStatement* statement,
                                           const CassResult* result) {
   statement->set_paging_state(result->paging_state());
+  statement->update_page_size(result->rows_size(), result->row_count());
   return CASS_OK;
 }
 
@@ -239,6 +326,32 @@ CassError cass_statement_bind_bytes(CassStatement* statement, size_t index,
   return statement->bind(index, value);
 }
 
+CassError cass_statement_bind_string_ref(CassStatement* statement,
+                                         size_t index,
+                                         CassString value,
+                                         CassValueReleaseCallback release_callback,
+                                         void* data) {
+  // The callback is called when the last reference is released, including
+  // this one if the value isn't bound
+  cass::ScopedRefPtr<cass::BufferReference> reference(
+        new cass::BufferReference(reinterpret_cast<const cass_byte_t*>(value.data),
+                                  value.length, release_callback, data));
+  CassStringRef ref = { reference.get() };
+  return statement->bind(index, ref);
+}
+
+CassError cass_statement_bind_bytes_ref(CassStatement* statement,
+                                        size_t index,
+                                        CassBytes value,
+                                        CassValueReleaseCallback release_callback,
+                                        void* data) {
+  cass::ScopedRefPtr<cass::BufferReference> reference(
+        new cass::BufferReference(value.data, value.size,
+                                  release_callback, data));
+  CassBytesRef ref = { reference.get() };
+  return statement->bind(index, ref);
+}
+
 CassError cass_statement_bind_uuid(CassStatement* statement, size_t index,
                                    const CassUuid value) {
   return statement->bind(index, value);
@@ -315,6 +428,30 @@ CassError cass_statement_bind_bytes_by_name(CassStatement* statement,
   return bind_by_name<CassBytes>(statement, name, value);
 }
 
+CassError cass_statement_bind_string_ref_by_name(CassStatement* statement,
+                                                 const char* name,
+                                                 CassString value,
+                                                 CassValueReleaseCallback release_callback,
+                                                 void* data) {
+  cass::ScopedRefPtr<cass::BufferReference> reference(
+        new cass::BufferReference(reinterpret_cast<const cass_byte_t*>(value.data),
+                                  value.length, release_callback, data));
+  CassStringRef ref = { reference.get() };
+  return bind_by_name<CassStringRef>(statement, name, ref);
+}
+
+CassError cass_statement_bind_bytes_ref_by_name(CassStatement* statement,
+                                                const char* name,
+                                                CassBytes value,
+                                                CassValueReleaseCallback release_callback,
+                                                void* data) {
+  cass::ScopedRefPtr<cass::BufferReference> reference(
+        new cass::BufferReference(value.data, value.size,
+                                  release_callback, data));
+  CassBytesRef ref = { reference.get() };
+  return bind_by_name<CassBytesRef>(statement, name, ref);
+}
+
 CassError cass_statement_bind_uuid_by_name(CassStatement* statement,
                                            const char* name,
                                            const CassUuid value) {
@@ -349,10 +486,189 @@ CassError cass_statement_bind_collection_by_name(CassStatement* statement,
   return bind_by_name<const CassCollection*>(statement, name, collection);
 }
 
+CassError cass_statement_bind_int32_by_handle(CassStatement* statement,
+                                              CassColumnHandle handle,
+                                              cass_int32_t value) {
+  return bind_by_handle<cass_int32_t>(statement, handle, value);
+}
+
+CassError cass_statement_bind_int64_by_handle(CassStatement* statement,
+                                              CassColumnHandle handle,
+                                              cass_int64_t value) {
+  return bind_by_handle<cass_int64_t>(statement, handle, value);
+}
+
+CassError cass_statement_bind_float_by_handle(CassStatement* statement,
+                                              CassColumnHandle handle,
+                                              cass_float_t value) {
+  return bind_by_handle<cass_float_t>(statement, handle, value);
+}
+
+CassError cass_statement_bind_double_by_handle(CassStatement* statement,
+                                               CassColumnHandle handle,
+                                               cass_double_t value) {
+  return bind_by_handle<cass_double_t>(statement, handle, value);
+}
+
+CassError cass_statement_bind_bool_by_handle(CassStatement* statement,
+                                             CassColumnHandle handle,
+                                             cass_bool_t value) {
+  return bind_by_handle<bool>(statement, handle, value == cass_true);
+}
+
+CassError cass_statement_bind_string_by_handle(CassStatement* statement,
+                                               CassColumnHandle handle,
+                                               CassString value) {
+  return bind_by_handle<CassString>(statement, handle, value);
+}
+
+CassError cass_statement_bind_bytes_by_handle(CassStatement* statement,
+                                              CassColumnHandle handle,
+                                              CassBytes value) {
+  return bind_by_handle<CassBytes>(statement, handle, value);
+}
+
+CassError cass_statement_bind_string_ref_by_handle(CassStatement* statement,
+                                                   CassColumnHandle handle,
+                                                   CassString value,
+                                                   CassValueReleaseCallback release_callback,
+                                                   void* data) {
+  cass::ScopedRefPtr<cass::BufferReference> reference(
+        new cass::BufferReference(reinterpret_cast<const cass_byte_t*>(value.data),
+                                  value.length, release_callback, data));
+  CassStringRef ref = { reference.get() };
+  return bind_by_handle<CassStringRef>(statement, handle, ref);
+}
+
+CassError cass_statement_bind_bytes_ref_by_handle(CassStatement* statement,
+                                                  CassColumnHandle handle,
+                                                  CassBytes value,
+                                                  CassValueReleaseCallback release_callback,
+                                                  void* data) {
+  cass::ScopedRefPtr<cass::BufferReference> reference(
+        new cass::BufferReference(value.data, value.size,
+                                  release_callback, data));
+  CassBytesRef ref = { reference.get() };
+  return bind_by_handle<CassBytesRef>(statement, handle, ref);
+}
+
+CassError cass_statement_bind_uuid_by_handle(CassStatement* statement,
+                                             CassColumnHandle handle,
+                                             const CassUuid value) {
+  return bind_by_handle<const CassUuid>(statement, handle, value);
+}
+
+CassError cass_statement_bind_inet_by_handle(CassStatement* statement,
+                                             CassColumnHandle handle,
+                                             CassInet value) {
+  return bind_by_handle<CassInet>(statement, handle, value);
+}
+
+CassError cass_statement_bind_decimal_by_handle(CassStatement* statement,
+                                                CassColumnHandle handle,
+                                                CassDecimal value) {
+  return bind_by_handle<CassDecimal>(statement, handle, value);
+}
+
+CassError cass_statement_bind_custom_by_handle(CassStatement* statement,
+                                               CassColumnHandle handle,
+                                               cass_size_t size,
+                                               cass_byte_t** output) {
+  CassCustom custom;
+  custom.output = output;
+  custom.output_size = size;
+  return bind_by_handle<CassCustom>(statement, handle, custom);
+}
+
+CassError cass_statement_bind_collection_by_handle(CassStatement* statement,
+                                                   CassColumnHandle handle,
+                                                   const CassCollection* collection) {
+  return bind_by_handle<const CassCollection*>(statement, handle, collection);
+}
+
 } // extern "C"
 
 namespace cass {
 
+void Statement::reset() {
+  unfreeze();
+  spare_values_.resize(values_.size());
+  for (size_t i = 0; i < values_.size(); ++i) {
+    Buffer& value = values_[i];
+    if (value.reuse(value.size())) {
+      spare_values_[i] = value;
+    }
+    value = Buffer();
+  }
+  paging_state_.clear();
+}
+
+void Statement::set_page_size_bytes(size_t page_size_bytes,
+                                    int32_t min_page_size,
+                                    int32_t max_page_size) {
+  page_size_bytes_ = page_size_bytes;
+  min_page_size_ = min_page_size;
+  max_page_size_ = max_page_size;
+  if (page_size_bytes_ == 0) return;
+
+  if (bytes_per_row_ == 0) {
+    // Nothing is known about the rows yet so start small
+    page_size_ = min_page_size_;
+  } else {
+    update_page_size(0, 0);
+  }
+}
+
+void Statement::update_page_size(size_t rows_size, int32_t row_count) {
+  if (page_size_bytes_ == 0) return;
+
+  if (row_count > 0) {
+    // Average with the previous pages, weighted towards the latest one
+    size_t bytes_per_row = rows_size / row_count;
+    if (bytes_per_row == 0) bytes_per_row = 1;
+    bytes_per_row_ = bytes_per_row_ == 0
+                     ? bytes_per_row
+                     : (bytes_per_row_ + bytes_per_row) / 2;
+  }
+
+  if (bytes_per_row_ == 0) return;
+
+  size_t page_size = page_size_bytes_ / bytes_per_row_;
+  if (page_size < static_cast<size_t>(min_page_size_)) {
+    page_size_ = min_page_size_;
+  } else if (page_size > static_cast<size_t>(max_page_size_)) {
+    page_size_ = max_page_size_;
+  } else {
+    page_size_ = static_cast<int32_t>(page_size);
+  }
+}
+
+void Statement::copy_values_and_settings(const Statement& statement) {
+  assert(values_.size() == statement.values_.size());
+  values_ = statement.values_;
+  consistency_ = statement.consistency_;
+  serial_consistency_ = statement.serial_consistency_;
+  page_size_ = statement.page_size_;
+  set_request_timeout(statement.request_timeout());
+  set_request_class(statement.request_class());
+}
+
+Buffer& Statement::value_buffer(size_t index, size_t size) {
+  Buffer& value = values_[index];
+  if (value.reuse(size)) {
+    return value;
+  }
+
+  if (index < spare_values_.size() && spare_values_[index].reuse(size)) {
+    value = spare_values_[index];
+    spare_values_[index] = Buffer();
+  } else {
+    value = Buffer(size);
+  }
+
+  return value;
+}
+
 int32_t Statement::encode_values(int version, BufferVec* bufs) const {
   int32_t values_size = 0;
   for (ValueVec::const_iterator it = values_.begin(), end = values_.end();
@@ -364,6 +680,14 @@ int32_t Statement::encode_values(int version, BufferVec* bufs) const {
       values_size += sizeof(int32_t);
     } else if (it->is_collection()) {
       values_size += it->collection()->encode(version, bufs);
+    } else if (it->is_reference()) {
+      // The value is written directly from the application's memory
+      size_t size = it->reference()->size();
+      Buffer buf(sizeof(int32_t));
+      buf.encode_int32(0, size);
+      bufs->push_back(buf);
+      bufs->push_back(*it);
+      values_size += sizeof(int32_t) + size;
     } else {
       bufs->push_back(*it);
       values_size += it->size();
@@ -372,4 +696,38 @@ int32_t Statement::encode_values(int version, BufferVec* bufs) const {
   return values_size;
 }
 
+int32_t Statement::values_size(int version) const {
+  int32_t size = 0;
+  for (ValueVec::const_iterator it = values_.begin(), end = values_.end();
+       it != end; ++it) {
+    if (it->is_empty()) {
+      size += sizeof(int32_t);
+    } else if (it->is_collection()) {
+      size += it->collection()->encoded_size(version);
+    } else if (it->is_reference()) {
+      // Copying the value into a single buffer would defeat the reference
+      return ENCODE_ERROR_NO_SINGLE_BUFFER;
+    } else {
+      size += it->size();
+    }
+  }
+  return size;
+}
+
+char* Statement::encode_values(int version, char* output) const {
+  char* pos = output;
+  for (ValueVec::const_iterator it = values_.begin(), end = values_.end();
+       it != end; ++it) {
+    if (it->is_empty()) {
+      pos = encode_int32(pos, -1); // [bytes] "null"
+    } else if (it->is_collection()) {
+      pos = it->collection()->encode(version, pos);
+    } else {
+      memcpy(pos, it->data(), it->size());
+      pos += it->size();
+    }
+  }
+  return pos;
+}
+
 } // namespace  cass
@@ -37,6 +37,14 @@ struct CassCustom {
 
 struct CassNull {};
 
+struct CassStringRef {
+  const cass::BufferReference* reference;
+};
+
+struct CassBytesRef {
+  const cass::BufferReference* reference;
+};
+
 namespace cass {
 
 class Statement : public Request {
@@ -47,7 +55,13 @@ public:
       , serial_consistency_(CASS_CONSISTENCY_ANY)
       , skip_metadata_(false)
       , page_size_(-1)
-      , kind_(kind) {}
+      , page_size_bytes_(0)
+      , min_page_size_(0)
+      , max_page_size_(0)
+      , bytes_per_row_(0)
+      , kind_(kind)
+      , row_callback_(NULL)
+      , row_callback_data_(NULL) {}
 
   Statement(uint8_t opcode, uint8_t kind, size_t value_count)
       : Request(opcode)
@@ -56,7 +70,13 @@ public:
       , serial_consistency_(CASS_CONSISTENCY_ANY)
       , skip_metadata_(false)
       , page_size_(-1)
-      , kind_(kind) {}
+      , page_size_bytes_(0)
+      , min_page_size_(0)
+      , max_page_size_(0)
+      , bytes_per_row_(0)
+      , kind_(kind)
+      , row_callback_(NULL)
+      , row_callback_data_(NULL) {}
 
   virtual ~Statement() {}
 
@@ -82,6 +102,14 @@ public:
 
   void set_page_size(int32_t page_size) { page_size_ = page_size; }
 
+  // The page size is adjusted so that pages are about "page_size_bytes"
+  // using the size of the rows in previous pages.
+  void set_page_size_bytes(size_t page_size_bytes,
+                           int32_t min_page_size, int32_t max_page_size);
+
+  // Records the size of a page returned for the statement
+  void update_page_size(size_t rows_size, int32_t row_count);
+
   const std::string paging_state() const { return paging_state_; }
 
   void set_paging_state(const std::string& paging_state) {
@@ -90,10 +118,28 @@ public:
 
   uint8_t kind() const { return kind_; }
 
+  // Rows are passed to the callback as they're decoded from the response
+  // instead of being kept in the result.
+  CassRowCallback row_callback() const { return row_callback_; }
+  void* row_callback_data() const { return row_callback_data_; }
+
+  void set_row_callback(CassRowCallback callback, void* data) {
+    row_callback_ = callback;
+    row_callback_data_ = data;
+  }
+
   virtual const std::string& query() const = 0;
 
   size_t values_count() const { return values_.size(); }
 
+  // Unbinds all values and clears the paging state. The values' storage is
+  // kept so binding new values to the statement doesn't allocate.
+  void reset();
+
+  // Copies the values and settings of a statement with the same number of
+  // values. The paging state and row callback aren't copied.
+  void copy_values_and_settings(const Statement& statement);
+
 #define BIND_FIXED_TYPE(DeclType, EncodeType, Size)                  \
   CassError bind(size_t index, const DeclType& value) { \
     CASS_VALUE_CHECK_INDEX(index);                                   \
@@ -142,11 +188,11 @@ public:
 
   CassError bind(size_t index, CassDecimal value) {
     CASS_VALUE_CHECK_INDEX(index);
-    Buffer buf(sizeof(int32_t) + sizeof(int32_t) + value.varint.size);
+    Buffer& buf = value_buffer(index, sizeof(int32_t) + sizeof(int32_t) +
+                                      value.varint.size);
     size_t pos = buf.encode_int32(0, sizeof(int32_t) + value.varint.size);
     pos = buf.encode_int32(pos, value.scale);
     buf.copy(pos, value.varint.data, value.varint.size);
-    values_[index] = buf;
     return CASS_OK;
   }
 
@@ -155,28 +201,44 @@ public:
     if (collection->is_map() && collection->item_count() % 2 != 0) {
       return CASS_ERROR_LIB_INVALID_ITEM_COUNT;
     }
-    values_[index] = Buffer(collection);
+    // Appending to the collection afterwards doesn't change the snapshot
+    values_[index] = Buffer(collection->snapshot());
     return CASS_OK;
   }
 
+  CassError bind(size_t index, CassStringRef value) {
+    return bind(index, value.reference);
+  }
+
+  CassError bind(size_t index, CassBytesRef value) {
+    return bind(index, value.reference);
+  }
+
   CassError bind(size_t index, CassCustom custom) {
     CASS_VALUE_CHECK_INDEX(index);
-    Buffer buf(4 + custom.output_size);
+    Buffer& buf = value_buffer(index, 4 + custom.output_size);
     size_t pos = buf.encode_int32(0, custom.output_size);
     *(custom.output) = reinterpret_cast<uint8_t*>(const_cast<char*>(buf.data() + pos));
-    values_[index] = buf;
     return CASS_OK;
   }
 
   int32_t encode_values(int version, BufferVec*  bufs) const;
 
+  int32_t values_size(int version) const;
+  char* encode_values(int version, char* output) const;
+
 private:
+  CassError bind(size_t index, const BufferReference* reference) {
+    CASS_VALUE_CHECK_INDEX(index);
+    values_[index] = Buffer(reference);
+    return CASS_OK;
+  }
+
   CassError bind(size_t index, const char* value, size_t value_length) {
     CASS_VALUE_CHECK_INDEX(index);
-    Buffer buf(sizeof(int32_t) + value_length);
+    Buffer& buf = value_buffer(index, sizeof(int32_t) + value_length);
     size_t pos = buf.encode_int32(0, value_length);
     buf.copy(pos, value, value_length);
-    values_[index] = buf;
     return CASS_OK;
   }
 
@@ -184,16 +246,25 @@ private:
     return bind(index, reinterpret_cast<const char*>(value), value_length);
   }
 
+  Buffer& value_buffer(size_t index, size_t size);
+
 private:
   typedef std::vector<Buffer> ValueVec;
 
   ValueVec values_;
+  ValueVec spare_values_; // Storage kept by reset()
   int16_t consistency_;
   int16_t serial_consistency_;
   bool skip_metadata_;
   int32_t page_size_;
+  size_t page_size_bytes_;
+  int32_t min_page_size_;
+  int32_t max_page_size_;
+  size_t bytes_per_row_;
   std::string paging_state_;
   uint8_t kind_;
+  CassRowCallback row_callback_;
+  void* row_callback_data_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Statement);
@@ -57,4 +57,8 @@ std::string get_contact_points_from_cluster(CassCluster* cluster) {
   return str;
 }
 
+unsigned get_unprepared_count_from_session(CassSession* session) {
+  return session->prepared_registry()->unprepared_count();
+}
+
 } // namespace cass
@@ -31,6 +31,8 @@ int get_port_from_cluster(CassCluster* cluster);
 
 std::string get_contact_points_from_cluster(CassCluster* cluster);
 
+unsigned get_unprepared_count_from_session(CassSession* session);
+
 
 } // namespace cass
 
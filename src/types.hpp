@@ -28,6 +28,7 @@
 #include "row.hpp"
 #include "value.hpp"
 #include "iterator.hpp"
+#include "page_iterator.hpp"
 
 // This abstraction allows us to separate internal types from the
 // external opaque pointers that we expose.
@@ -56,6 +57,7 @@ EXTERNAL_TYPE(cass::BatchRequest, CassBatch);
 EXTERNAL_TYPE(cass::ResultResponse, CassResult);
 EXTERNAL_TYPE(cass::BufferCollection, CassCollection);
 EXTERNAL_TYPE(cass::Iterator, CassIterator);
+EXTERNAL_TYPE(cass::PageIterator, CassPageIterator);
 EXTERNAL_TYPE(cass::Row, CassRow);
 EXTERNAL_TYPE(cass::Value, CassValue);
 
@@ -16,8 +16,49 @@
 
 #include "value.hpp"
 
+#include "serialization.hpp"
 #include "types.hpp"
 
+#include <algorithm>
+
+namespace {
+
+// Collection elements are encoded as [short size][value]. Fixed width items
+// can be decoded as a strided run as long as every item has the expected
+// size.
+template <class T>
+bool get_items(const CassValue* collection, CassValueType type,
+               cass_size_t* count, char** data) {
+  if (collection->type() != CASS_VALUE_TYPE_LIST &&
+      collection->type() != CASS_VALUE_TYPE_SET) {
+    return false;
+  }
+  if (collection->primary_type() != type) {
+    return false;
+  }
+  const size_t stride = sizeof(uint16_t) + sizeof(T);
+  const size_t item_count = collection->count();
+  if (collection->buffer().size() < 0 ||
+      static_cast<size_t>(collection->buffer().size()) != item_count * stride) {
+    return false;
+  }
+  *count = std::min(*count, item_count);
+  // The total size can match even if the items don't (e.g. a short item
+  // followed by a long one) so every size is checked before decoding.
+  char* pos = collection->buffer().data();
+  for (size_t i = 0; i < *count; ++i, pos += stride) {
+    uint16_t size = 0;
+    cass::decode_uint16(pos, size);
+    if (size != sizeof(T)) {
+      return false;
+    }
+  }
+  *data = collection->buffer().data() + sizeof(uint16_t);
+  return true;
+}
+
+} // namespace
+
 extern "C" {
 
 CassError cass_value_get_int32(const CassValue* value, cass_int32_t* output) {
@@ -128,4 +169,52 @@ CassValueType cass_value_secondary_sub_type(const CassValue* collection) {
   return collection->secondary_type();
 }
 
+cass_size_t cass_value_get_items_int32(const CassValue* collection,
+                                       cass_int32_t* output,
+                                       cass_size_t count) {
+  char* data;
+  if (!get_items<cass_int32_t>(collection, CASS_VALUE_TYPE_INT, &count, &data)) {
+    return 0;
+  }
+  cass::decode_int32_run(data, sizeof(uint16_t) + sizeof(cass_int32_t),
+                         count, output);
+  return count;
+}
+
+cass_size_t cass_value_get_items_int64(const CassValue* collection,
+                                       cass_int64_t* output,
+                                       cass_size_t count) {
+  char* data;
+  if (!get_items<cass_int64_t>(collection, CASS_VALUE_TYPE_BIGINT, &count, &data)) {
+    return 0;
+  }
+  cass::decode_int64_run(data, sizeof(uint16_t) + sizeof(cass_int64_t),
+                         count, output);
+  return count;
+}
+
+cass_size_t cass_value_get_items_float(const CassValue* collection,
+                                       cass_float_t* output,
+                                       cass_size_t count) {
+  char* data;
+  if (!get_items<cass_float_t>(collection, CASS_VALUE_TYPE_FLOAT, &count, &data)) {
+    return 0;
+  }
+  cass::decode_float_run(data, sizeof(uint16_t) + sizeof(cass_float_t),
+                         count, output);
+  return count;
+}
+
+cass_size_t cass_value_get_items_double(const CassValue* collection,
+                                        cass_double_t* output,
+                                        cass_size_t count) {
+  char* data;
+  if (!get_items<cass_double_t>(collection, CASS_VALUE_TYPE_DOUBLE, &count, &data)) {
+    return 0;
+  }
+  cass::decode_double_run(data, sizeof(uint16_t) + sizeof(cass_double_t),
+                          count, output);
+  return count;
+}
+
 } // extern "C"
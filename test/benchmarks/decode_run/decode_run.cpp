@@ -0,0 +1,76 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "serialization.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+// Compares decode_int64_run() against decoding collection items one value at
+// a time.
+
+int main(int argc, char* argv[]) {
+  const size_t count = 1024 * 1024;
+  const size_t stride = sizeof(uint16_t) + sizeof(cass_int64_t);
+  int iterations = 20;
+
+  if (argc > 1) {
+    iterations = atoi(argv[1]);
+  }
+
+  std::vector<cass_int64_t> values(count);
+  std::vector<char> data(count * stride);
+  char* pos = &data[0];
+  for (size_t i = 0; i < count; ++i, pos += stride) {
+    values[i] = static_cast<cass_int64_t>(i) * 0x0101010101LL;
+    cass::encode_int64(cass::encode_uint16(pos, sizeof(cass_int64_t)),
+                       values[i]);
+  }
+
+  std::vector<cass_int64_t> output(count);
+
+  clock_t start = clock();
+  for (int n = 0; n < iterations; ++n) {
+    pos = &data[0] + sizeof(uint16_t);
+    for (size_t i = 0; i < count; ++i, pos += stride) {
+      cass::decode_int64(pos, output[i]);
+    }
+  }
+  clock_t scalar = clock() - start;
+  if (output != values) {
+    fprintf(stderr, "decode_int64 produced the wrong values\n");
+    return 1;
+  }
+
+  start = clock();
+  for (int n = 0; n < iterations; ++n) {
+    cass::decode_int64_run(&data[0] + sizeof(uint16_t), stride,
+                           count, &output[0]);
+  }
+  clock_t run = clock() - start;
+  if (output != values) {
+    fprintf(stderr, "decode_int64_run produced the wrong values\n");
+    return 1;
+  }
+
+  printf("decode_int64: %.2f ms, decode_int64_run: %.2f ms\n",
+         (1000.0 * scalar) / CLOCKS_PER_SEC,
+         (1000.0 * run) / CLOCKS_PER_SEC);
+
+  return 0;
+}
@@ -149,5 +149,72 @@ BOOST_AUTO_TEST_CASE(test_after_set)
   BOOST_CHECK(callback_data->was_called);
 }
 
+BOOST_AUTO_TEST_CASE(test_cancel)
+{
+  boost::scoped_ptr<CallbackData> callback_data(new CallbackData());
+
+  test_utils::CassFuturePtr connect_future(cass_cluster_connect(cluster));
+  test_utils::wait_and_check_error(connect_future.get());
+  test_utils::CassSessionPtr session(cass_future_get_session(connect_future.get()));
+
+  test_utils::CassStatementPtr statement(cass_statement_new(cass_string_init("SELECT * FROM system.schema_keyspaces"), 0));
+  test_utils::CassFuturePtr future(cass_session_execute(session.get(), statement.get()));
+
+  cass_future_set_callback(future.get(), check_callback, callback_data.get());
+
+  BOOST_REQUIRE(cass_future_cancel(future.get()) == CASS_OK);
+
+  // The future is always set after being cancelled, the request may have
+  // already finished.
+  BOOST_CHECK(cass_future_ready(future.get()));
+  CassError code = cass_future_error_code(future.get());
+  BOOST_CHECK(code == CASS_OK || code == CASS_ERROR_LIB_REQUEST_CANCELLED);
+
+  callback_data->wait();
+
+  BOOST_CHECK(callback_data->was_called);
+}
+
+BOOST_AUTO_TEST_CASE(test_cancel_pending)
+{
+  // Only one request can be in flight so the rest wait in the pool
+  cass_cluster_set_num_threads_io(cluster, 1);
+  cass_cluster_set_core_connections_per_host(cluster, 1);
+  cass_cluster_set_adaptive_concurrency(cluster, cass_true);
+  cass_cluster_set_adaptive_concurrency_limits(cluster, 1, 1);
+
+  test_utils::CassFuturePtr connect_future(cass_cluster_connect(cluster));
+  test_utils::wait_and_check_error(connect_future.get());
+  test_utils::CassSessionPtr session(cass_future_get_session(connect_future.get()));
+
+  test_utils::execute_query(session.get(), str(boost::format(test_utils::CREATE_KEYSPACE_SIMPLE_FORMAT)
+                                               % test_utils::SIMPLE_KEYSPACE % "1"));
+  test_utils::execute_query(session.get(), str(boost::format("USE %s") % test_utils::SIMPLE_KEYSPACE));
+  test_utils::execute_query(session.get(), "CREATE TABLE cancel_pending (key int PRIMARY KEY, value int);");
+
+  std::vector<test_utils::CassFuturePtr> futures;
+  for (int i = 0; i < 32; ++i) {
+    test_utils::CassStatementPtr statement(cass_statement_new(cass_string_init("SELECT * FROM system.schema_columns"), 0));
+    futures.push_back(test_utils::CassFuturePtr(cass_session_execute(session.get(), statement.get())));
+  }
+
+  test_utils::CassStatementPtr insert(cass_statement_new(cass_string_init("INSERT INTO cancel_pending (key, value) VALUES (1, 1)"), 0));
+  test_utils::CassFuturePtr future(cass_session_execute(session.get(), insert.get()));
+
+  BOOST_REQUIRE(cass_future_cancel(future.get()) == CASS_OK);
+  BOOST_CHECK(cass_future_error_code(future.get()) == CASS_ERROR_LIB_REQUEST_CANCELLED);
+
+  for (std::vector<test_utils::CassFuturePtr>::iterator it = futures.begin(),
+       end = futures.end(); it != end; ++it) {
+    test_utils::wait_and_check_error(it->get());
+  }
+
+  // The cancelled request was queued behind the others and must never have
+  // been written
+  test_utils::CassResultPtr result;
+  test_utils::execute_query(session.get(), "SELECT * FROM cancel_pending", &result);
+  BOOST_CHECK(cass_result_row_count(result.get()) == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -19,6 +19,8 @@
 #   define BOOST_TEST_MODULE cassandra
 #endif
 
+#include <stdio.h>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/test/debug.hpp>
 #include <boost/lexical_cast.hpp>
@@ -31,6 +33,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/move/move.hpp>
 #include <boost/container/vector.hpp>
+#include <boost/chrono.hpp>
 
 #include "cassandra.h"
 #include "test_utils.hpp"
@@ -395,4 +398,99 @@ BOOST_AUTO_TEST_CASE(test_massive_number_of_prepares)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_prepared_cache)
+{
+  std::string select_query = str(boost::format("SELECT * FROM %s WHERE id = ?;") % ALL_TYPE_TABLE_NAME);
+
+  // Concurrent prepares of the same query share a single request
+  test_utils::CassFuturePtr prepared_future1(cass_session_prepare(session,
+                                                                  cass_string_init2(select_query.data(), select_query.size())));
+  test_utils::CassFuturePtr prepared_future2(cass_session_prepare(session,
+                                                                  cass_string_init2(select_query.data(), select_query.size())));
+  test_utils::wait_and_check_error(prepared_future1.get());
+  test_utils::wait_and_check_error(prepared_future2.get());
+  test_utils::CassPreparedPtr prepared1(cass_future_get_prepared(prepared_future1.get()));
+  test_utils::CassPreparedPtr prepared2(cass_future_get_prepared(prepared_future2.get()));
+  BOOST_REQUIRE(prepared1.get() != NULL);
+  BOOST_CHECK(prepared1.get() == prepared2.get());
+
+  // Later prepares are set immediately with the cached statement
+  test_utils::CassFuturePtr prepared_future3(cass_session_prepare(session,
+                                                                  cass_string_init2(select_query.data(), select_query.size())));
+  BOOST_CHECK(cass_future_ready(prepared_future3.get()) == cass_true);
+  test_utils::CassPreparedPtr prepared3(cass_future_get_prepared(prepared_future3.get()));
+  BOOST_CHECK(prepared1.get() == prepared3.get());
+
+  // A cached statement can be bound and executed as usual
+  test_utils::CassStatementPtr statement(cass_prepared_bind(prepared3.get()));
+  BOOST_REQUIRE(cass_statement_bind_uuid(statement.get(), 0, test_utils::generate_time_uuid().uuid) == CASS_OK);
+  test_utils::CassFuturePtr future(cass_session_execute(session, statement.get()));
+  test_utils::wait_and_check_error(future.get());
+}
+
+BOOST_AUTO_TEST_CASE(test_prepared_cache_schema_change)
+{
+  std::string table_name = str(boost::format("table_%s") % test_utils::generate_unique_str());
+  test_utils::execute_query(session, str(boost::format("CREATE TABLE %s (key int PRIMARY KEY, value int);") % table_name));
+  test_utils::execute_query(session, str(boost::format("INSERT INTO %s (key, value) VALUES (1, 2);") % table_name));
+
+  std::string select_query = str(boost::format("SELECT * FROM %s WHERE key = 1;") % table_name);
+  test_utils::CassFuturePtr prepared_future1(cass_session_prepare(session,
+                                                                  cass_string_init2(select_query.data(), select_query.size())));
+  test_utils::wait_and_check_error(prepared_future1.get());
+  test_utils::CassPreparedPtr prepared1(cass_future_get_prepared(prepared_future1.get()));
+
+  test_utils::execute_query(session, str(boost::format("ALTER TABLE %s ADD other int;") % table_name));
+
+  // Wait for the schema change event
+  boost::this_thread::sleep_for(boost::chrono::seconds(1));
+
+  // The existing statement no longer skips the result metadata
+  test_utils::CassStatementPtr statement(cass_prepared_bind(prepared1.get()));
+  test_utils::CassFuturePtr future(cass_session_execute(session, statement.get()));
+  test_utils::wait_and_check_error(future.get());
+  test_utils::CassResultPtr result(cass_future_get_result(future.get()));
+  BOOST_REQUIRE(cass_result_row_count(result.get()) == 1);
+
+  // The schema change removed the statement from the cache
+  test_utils::CassFuturePtr prepared_future2(cass_session_prepare(session,
+                                                                  cass_string_init2(select_query.data(), select_query.size())));
+  test_utils::wait_and_check_error(prepared_future2.get());
+  test_utils::CassPreparedPtr prepared2(cass_future_get_prepared(prepared_future2.get()));
+  BOOST_CHECK(prepared1.get() != prepared2.get());
+}
+
+BOOST_AUTO_TEST_CASE(test_prepared_cache_file)
+{
+  std::string path = str(boost::format("/tmp/prepared_%s.cache") % test_utils::generate_unique_str());
+  std::string select_query = str(boost::format("SELECT * FROM %s.%s WHERE id = ?;")
+                                 % test_utils::SIMPLE_KEYSPACE % ALL_TYPE_TABLE_NAME);
+
+  cass_cluster_set_prepared_cache_file(cluster, path.c_str());
+
+  {
+    test_utils::CassSessionPtr session(test_utils::create_session(cluster));
+    test_utils::CassFuturePtr prepared_future(cass_session_prepare(session.get(),
+                                                                   cass_string_init2(select_query.data(), select_query.size())));
+    test_utils::wait_and_check_error(prepared_future.get());
+  }
+
+  {
+    // The statement is loaded from the file when the session connects
+    test_utils::CassSessionPtr session(test_utils::create_session(cluster));
+    test_utils::CassFuturePtr prepared_future(cass_session_prepare(session.get(),
+                                                                   cass_string_init2(select_query.data(), select_query.size())));
+    BOOST_CHECK(cass_future_ready(prepared_future.get()) == cass_true);
+    test_utils::CassPreparedPtr prepared(cass_future_get_prepared(prepared_future.get()));
+    BOOST_REQUIRE(prepared.get() != NULL);
+
+    test_utils::CassStatementPtr statement(cass_prepared_bind(prepared.get()));
+    BOOST_REQUIRE(cass_statement_bind_uuid(statement.get(), 0, test_utils::generate_time_uuid().uuid) == CASS_OK);
+    test_utils::CassFuturePtr future(cass_session_execute(session.get(), statement.get()));
+    test_utils::wait_and_check_error(future.get());
+  }
+
+  remove(path.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
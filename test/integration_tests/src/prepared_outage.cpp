@@ -31,6 +31,7 @@
 
 #include "cql_ccm_bridge.hpp"
 #include "cassandra.h"
+#include "testing.hpp"
 #include "test_utils.hpp"
 
 struct PreparedOutageTests : public test_utils::SingleSessionTest {
@@ -97,4 +98,39 @@ BOOST_AUTO_TEST_CASE(test_reprepared_on_new_node)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_prepared_on_all_hosts)
+{
+  test_utils::CassSessionPtr session(test_utils::create_session(cluster));
+  test_utils::execute_query(session.get(), str(boost::format("USE %s") % test_utils::SIMPLE_KEYSPACE));
+  test_utils::execute_query(session.get(), "CREATE TABLE test_all_hosts (key text PRIMARY KEY, value int);");
+  test_utils::execute_query(session.get(), "INSERT INTO test_all_hosts (key, value) VALUES ('abc', 1);");
+
+  std::string select_query = "SELECT * FROM test_all_hosts WHERE key = ?;";
+  test_utils::CassFuturePtr prepared_future(cass_session_prepare(session.get(),
+                                                                 cass_string_init2(select_query.data(), select_query.size())));
+  test_utils::wait_and_check_error(prepared_future.get());
+  test_utils::CassPreparedPtr prepared(cass_future_get_prepared(prepared_future.get()));
+
+  // Give the other host time to prepare the statement in the background
+  boost::this_thread::sleep_for(boost::chrono::seconds(1));
+
+  // Restart a host, it should have the statement prepared before it takes requests
+  ccm->stop(2);
+  ccm->start(2);
+  boost::this_thread::sleep_for(boost::chrono::seconds(10));
+
+  // The round robin policy sends these to both hosts
+  for (int i = 0; i < 10; ++i) {
+    test_utils::CassStatementPtr statement(cass_prepared_bind(prepared.get()));
+    BOOST_REQUIRE(cass_statement_bind_string(statement.get(), 0, cass_string_init("abc")) == CASS_OK);
+    test_utils::CassFuturePtr future(cass_session_execute(session.get(), statement.get()));
+    test_utils::wait_and_check_error(future.get());
+    test_utils::CassResultPtr result(cass_future_get_result(future.get()));
+    BOOST_REQUIRE(cass_result_row_count(result.get()) == 1);
+  }
+
+  // Neither host had to be told about the statement by an UNPREPARED error
+  BOOST_CHECK_EQUAL(cass::get_unprepared_count_from_session(session.get()), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
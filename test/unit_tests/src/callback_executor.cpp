@@ -0,0 +1,176 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "callback_executor.hpp"
+#include "cluster.hpp"
+#include "future.hpp"
+#include "types.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <uv.h>
+
+#include <vector>
+
+namespace {
+
+struct CallbackData {
+  CallbackData()
+    : count(0) {
+    uv_mutex_init(&mutex);
+  }
+
+  ~CallbackData() {
+    uv_mutex_destroy(&mutex);
+  }
+
+  uv_mutex_t mutex;
+  int count;
+  std::vector<unsigned long> threads;
+};
+
+void on_callback(CassFuture* future, void* data) {
+  CallbackData* callback_data = static_cast<CallbackData*>(data);
+  uv_mutex_lock(&callback_data->mutex);
+  callback_data->count++;
+  callback_data->threads.push_back(static_cast<unsigned long>(uv_thread_self()));
+  uv_mutex_unlock(&callback_data->mutex);
+}
+
+struct CloseData {
+  cass::CallbackExecutor* executor;
+  uv_sem_t done;
+};
+
+// Frees the executor from its own thread like a callback freeing the session
+void on_close_callback(CassFuture* future, void* data) {
+  CloseData* close_data = static_cast<CloseData*>(data);
+  delete close_data->executor;
+  uv_sem_post(&close_data->done);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(callback_executor)
+
+BOOST_AUTO_TEST_CASE(run_callbacks)
+{
+  const int future_count = 1000;
+  CallbackData data;
+
+  cass::CallbackExecutor executor;
+  BOOST_REQUIRE(executor.init() == 0);
+
+  for (int i = 0; i < future_count; ++i) {
+    cass::SharedRefPtr<cass::Future> future(
+          new cass::Future(cass::CASS_FUTURE_TYPE_RESPONSE));
+    future->set_loop(uv_default_loop());
+    future->set_callback_executor(&executor);
+    future->set_callback(on_callback, &data);
+    future->set();
+  }
+
+  // Pending callbacks are run before the thread stops
+  executor.close_and_join();
+
+  BOOST_REQUIRE(data.count == future_count);
+  unsigned long self = static_cast<unsigned long>(uv_thread_self());
+  for (size_t i = 0; i < data.threads.size(); ++i) {
+    BOOST_CHECK(data.threads[i] == data.threads[0]);
+    BOOST_CHECK(data.threads[i] != self);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(submit_after_close)
+{
+  CallbackData data;
+
+  cass::CallbackExecutor executor;
+  BOOST_REQUIRE(executor.init() == 0);
+  executor.close_and_join();
+
+  // The thread is gone so the callback runs on the thread setting the future
+  cass::SharedRefPtr<cass::Future> future(
+        new cass::Future(cass::CASS_FUTURE_TYPE_RESPONSE));
+  future->set_loop(uv_default_loop());
+  future->set_callback_executor(&executor);
+  future->set_callback(on_callback, &data);
+  future->set();
+
+  BOOST_REQUIRE(data.count == 1);
+  BOOST_CHECK(data.threads[0] == static_cast<unsigned long>(uv_thread_self()));
+}
+
+BOOST_AUTO_TEST_CASE(close_from_callback)
+{
+  CloseData data;
+  data.executor = new cass::CallbackExecutor();
+  BOOST_REQUIRE(data.executor->init() == 0);
+  BOOST_REQUIRE(uv_sem_init(&data.done, 0) == 0);
+
+  cass::SharedRefPtr<cass::Future> future(
+        new cass::Future(cass::CASS_FUTURE_TYPE_RESPONSE));
+  future->set_loop(uv_default_loop());
+  future->set_callback_executor(data.executor);
+  future->set_callback(on_close_callback, &data);
+  future->set();
+
+  // Deadlocks if the executor's thread joins itself
+  uv_sem_wait(&data.done);
+  uv_sem_destroy(&data.done);
+}
+
+BOOST_AUTO_TEST_CASE(inline_callbacks)
+{
+  CallbackData data;
+
+  cass::SharedRefPtr<cass::Future> future(
+        new cass::Future(cass::CASS_FUTURE_TYPE_RESPONSE));
+  future->set_loop(uv_default_loop());
+  future->set_callback_inline();
+  future->set_callback(on_callback, &data);
+  future->set();
+
+  BOOST_REQUIRE(data.count == 1);
+  BOOST_CHECK(data.threads[0] == static_cast<unsigned long>(uv_thread_self()));
+}
+
+BOOST_AUTO_TEST_CASE(callback_mode)
+{
+  CassCluster* cluster = cass_cluster_new();
+
+  BOOST_CHECK(cass_cluster_set_callback_mode(cluster,
+                                             CASS_CALLBACK_MODE_EXECUTOR) == CASS_OK);
+  BOOST_CHECK(cluster->config().callback_mode() == CASS_CALLBACK_MODE_EXECUTOR);
+
+  // Values outside the enum are rejected and the mode is unchanged
+  BOOST_CHECK(cass_cluster_set_callback_mode(cluster,
+                                             static_cast<CassCallbackMode>(3)) ==
+              CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cass_cluster_set_callback_mode(cluster,
+                                             static_cast<CassCallbackMode>(-1)) ==
+              CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cluster->config().callback_mode() == CASS_CALLBACK_MODE_EXECUTOR);
+
+  cass_cluster_free(cluster);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,227 @@
+/*
+  Copyright (c) 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "concurrency_limiter.hpp"
+#include "config.hpp"
+#include "io_worker.hpp"
+#include "load_balancing.hpp"
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "session.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace {
+
+// Visits the hosts in the order they're given
+class ListQueryPlan : public cass::QueryPlan {
+public:
+  ListQueryPlan(const std::vector<cass::Address>& hosts)
+    : hosts_(hosts)
+    , index_(0) {}
+
+  virtual bool compute_next(cass::Address* address) {
+    if (index_ >= hosts_.size()) return false;
+    *address = hosts_[index_++];
+    return true;
+  }
+
+private:
+  std::vector<cass::Address> hosts_;
+  size_t index_;
+};
+
+// Pools that never connect so every request sent to a host waits in its
+// pending queue, which holds a single request
+cass::Config overflow_config() {
+  cass::Config config;
+  config.set_core_connections_per_host(0);
+  config.set_max_pending_requests(1);
+  config.set_connect_timeout(10);
+  config.set_adaptive_concurrency(true);
+  config.set_log_level(CASS_LOG_DISABLED);
+  return config;
+}
+
+// Sends a request like the session does. An overflow address is the host a
+// retry remembers after skipping it for being at its concurrency limit.
+cass::SharedRefPtr<cass::ResponseFuture> execute(cass::IOWorker* io_worker,
+                                                 const std::vector<cass::Address>& hosts,
+                                                 const cass::Address* overflow_address = NULL) {
+  cass::SharedRefPtr<cass::QueryRequest> request(
+        new cass::QueryRequest("SELECT * FROM t"));
+  cass::SharedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  cass::RequestHandler* request_handler =
+      new cass::RequestHandler(request.get(), future.get());
+  request_handler->inc_ref(); // IOWorker reference
+  request_handler->set_query_plan(new ListQueryPlan(hosts));
+  if (overflow_address != NULL) {
+    request_handler->set_overflow_address(*overflow_address);
+  }
+  BOOST_REQUIRE(io_worker->execute(request_handler));
+  uv_run(io_worker->loop(), UV_RUN_NOWAIT);
+  return future;
+}
+
+void check_error(const cass::SharedRefPtr<cass::ResponseFuture>& future,
+                 CassError code) {
+  BOOST_REQUIRE(future->ready());
+  BOOST_REQUIRE(future->get_error() != NULL);
+  BOOST_CHECK(future->get_error()->code == code);
+}
+
+// Queued requests time out waiting for a connection and the worker closes
+void close(cass::IOWorker* io_worker) {
+  io_worker->close_async();
+  uv_run(io_worker->loop(), UV_RUN_DEFAULT);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(concurrency_limiter)
+
+BOOST_AUTO_TEST_CASE(increase)
+{
+  cass::ConcurrencyLimiter limiter(10, 20);
+  BOOST_CHECK(limiter.limit() == 10);
+  BOOST_CHECK(limiter.is_limited(10));
+  BOOST_CHECK(!limiter.is_limited(9));
+
+  // Fast responses while the limit is in use grow the limit
+  for (int i = 0; i < 1000; ++i) {
+    limiter.on_response(100, limiter.limit());
+  }
+  BOOST_CHECK(limiter.limit() == 20); // Never exceeds the max
+}
+
+BOOST_AUTO_TEST_CASE(no_increase_when_unused)
+{
+  cass::ConcurrencyLimiter limiter(10, 20);
+
+  for (int i = 0; i < 1000; ++i) {
+    limiter.on_response(100, 1);
+  }
+  BOOST_CHECK(limiter.limit() == 10);
+}
+
+BOOST_AUTO_TEST_CASE(decrease)
+{
+  cass::ConcurrencyLimiter limiter(10, 20);
+
+  limiter.on_response(100, 10);
+  unsigned limit = limiter.limit();
+
+  // Slow responses reduce the limit, at most once per window of
+  // "limit" responses (including the first response).
+  for (unsigned i = 0; i < limit - 2; ++i) {
+    BOOST_CHECK(!limiter.on_response(1000, 10));
+  }
+  BOOST_CHECK(limiter.on_response(1000, 10));
+  BOOST_CHECK(limiter.limit() < limit);
+}
+
+BOOST_AUTO_TEST_CASE(timeout)
+{
+  cass::ConcurrencyLimiter limiter(2, 20);
+
+  for (int i = 0; i < 100; ++i) {
+    limiter.on_timeout();
+  }
+  BOOST_CHECK(limiter.limit() == 1); // Never drops below one
+}
+
+BOOST_AUTO_TEST_CASE(config_limits)
+{
+  // The default maximum follows the number of connections per host
+  cass::Config config;
+  config.set_max_connections_per_host(8);
+  BOOST_CHECK(config.max_concurrency_limit() == 128 * 8);
+
+  // An explicit limit is kept regardless of the order of the settings
+  config.set_concurrency_limits(4, 16);
+  config.set_max_connections_per_host(16);
+  BOOST_CHECK(config.initial_concurrency_limit() == 4);
+  BOOST_CHECK(config.max_concurrency_limit() == 16);
+}
+
+BOOST_AUTO_TEST_CASE(overflow_to_next_host)
+{
+  cass::Session session(overflow_config());
+  BOOST_REQUIRE(session.init() == 0);
+  cass::IOWorker io_worker(&session);
+  BOOST_REQUIRE(io_worker.init() == 0);
+
+  std::vector<cass::Address> hosts;
+  hosts.push_back(cass::Address("127.0.0.1", 9042));
+  hosts.push_back(cass::Address("127.0.0.2", 9042));
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    BOOST_REQUIRE(io_worker.add_pool_async(hosts[i], false));
+  }
+  uv_run(io_worker.loop(), UV_RUN_NOWAIT);
+
+  // The first host's queue is full so the second request overflows to the
+  // next host in its query plan
+  cass::SharedRefPtr<cass::ResponseFuture> first(execute(&io_worker, hosts));
+  BOOST_CHECK(!first->ready());
+  cass::SharedRefPtr<cass::ResponseFuture> second(execute(&io_worker, hosts));
+  BOOST_CHECK(!second->ready());
+
+  // Every host is full so the request is rejected
+  cass::SharedRefPtr<cass::ResponseFuture> third(execute(&io_worker, hosts));
+  check_error(third, CASS_ERROR_LIB_NO_HOSTS_AVAILABLE);
+
+  close(&io_worker);
+  check_error(first, CASS_ERROR_LIB_NO_HOSTS_AVAILABLE);
+  check_error(second, CASS_ERROR_LIB_NO_HOSTS_AVAILABLE);
+}
+
+BOOST_AUTO_TEST_CASE(overflow_waits_on_saturated_host)
+{
+  cass::Session session(overflow_config());
+  BOOST_REQUIRE(session.init() == 0);
+  cass::IOWorker io_worker(&session);
+  BOOST_REQUIRE(io_worker.init() == 0);
+
+  cass::Address saturated("127.0.0.1", 9042);
+  BOOST_REQUIRE(io_worker.add_pool_async(saturated, false));
+  uv_run(io_worker.loop(), UV_RUN_NOWAIT);
+
+  // The only other host has no pool (it's down)
+  std::vector<cass::Address> hosts(1, cass::Address("127.0.0.2", 9042));
+
+  // With no host left the request waits on the host that was skipped for
+  // being at its concurrency limit...
+  cass::SharedRefPtr<cass::ResponseFuture> queued(
+        execute(&io_worker, hosts, &saturated));
+  BOOST_CHECK(!queued->ready());
+
+  // ...unless that host's queue is full
+  cass::SharedRefPtr<cass::ResponseFuture> rejected(
+        execute(&io_worker, hosts, &saturated));
+  check_error(rejected, CASS_ERROR_LIB_NO_HOSTS_AVAILABLE);
+
+  close(&io_worker);
+  check_error(queued, CASS_ERROR_LIB_NO_HOSTS_AVAILABLE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
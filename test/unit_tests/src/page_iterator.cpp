@@ -0,0 +1,250 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "page_iterator.hpp"
+#include "query_request.hpp"
+#include "test_utils.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+
+using test_utils::TestExecutor;
+
+namespace {
+
+std::string paging_state(int page) {
+  std::ostringstream ss;
+  ss << "page" << page;
+  return ss.str();
+}
+
+// Finishes the oldest request with a page whose only value is the page
+// number
+void finish_page(TestExecutor* executor, int page, bool has_more_pages) {
+  executor->finish(executor->next_pending(),
+                   test_utils::create_int_result(page,
+                                                 has_more_pages ? paging_state(page)
+                                                                : std::string()));
+}
+
+int page_number(const cass::ResultResponse* result) {
+  return test_utils::int_result_value(result);
+}
+
+cass::PageIterator* create_iterator(TestExecutor* executor,
+                                    cass::QueryRequest* statement,
+                                    size_t prefetch_count) {
+  statement->set_query("SELECT v FROM ks.t");
+  statement->set_page_size(1);
+  return new cass::PageIterator(executor, statement, prefetch_count);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(page_iterator)
+
+BOOST_AUTO_TEST_CASE(prefetch)
+{
+  TestExecutor executor;
+  cass::SharedRefPtr<cass::QueryRequest> statement(new cass::QueryRequest(0));
+  cass::SharedRefPtr<cass::PageIterator> iterator(
+        create_iterator(&executor, statement.get(), 2));
+
+  iterator->start();
+  BOOST_REQUIRE(executor.in_flight() == 1);
+
+  // The next page is requested as soon as the previous one arrives
+  finish_page(&executor, 0, true);
+  BOOST_REQUIRE(executor.in_flight() == 1);
+
+  // Only "prefetch_count" pages are fetched ahead of the application
+  finish_page(&executor, 1, true);
+  BOOST_CHECK(executor.in_flight() == 0);
+
+  cass::ScopedPtr<cass::ResultResponse> result(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 0);
+  BOOST_REQUIRE(executor.in_flight() == 1);
+
+  // Every request continues from the previous page
+  BOOST_REQUIRE(executor.request_count() == 3);
+  BOOST_CHECK(executor.paging_state(0).empty());
+  BOOST_CHECK(executor.paging_state(1) == paging_state(0));
+  BOOST_CHECK(executor.paging_state(2) == paging_state(1));
+
+  finish_page(&executor, 2, false);
+  result.reset(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 1);
+  result.reset(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(end_of_results)
+{
+  TestExecutor executor;
+  cass::SharedRefPtr<cass::QueryRequest> statement(new cass::QueryRequest(0));
+  cass::SharedRefPtr<cass::PageIterator> iterator(
+        create_iterator(&executor, statement.get(), 4));
+
+  iterator->start();
+  finish_page(&executor, 0, true);
+  finish_page(&executor, 1, false);
+
+  // Nothing is requested after the last page
+  BOOST_CHECK(executor.in_flight() == 0);
+  BOOST_CHECK(executor.request_count() == 2);
+
+  cass::ScopedPtr<cass::ResultResponse> result(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 0);
+  result.reset(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 1);
+
+  BOOST_CHECK(iterator->next_page() == NULL);
+  BOOST_CHECK(iterator->next_page() == NULL);
+  BOOST_CHECK(iterator->error_code() == CASS_OK);
+  BOOST_CHECK(iterator->error_message().empty());
+  BOOST_CHECK(executor.in_flight() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(error)
+{
+  TestExecutor executor;
+  cass::SharedRefPtr<cass::QueryRequest> statement(new cass::QueryRequest(0));
+  cass::SharedRefPtr<cass::PageIterator> iterator(
+        create_iterator(&executor, statement.get(), 4));
+
+  iterator->start();
+  finish_page(&executor, 0, true);
+  executor.fail(executor.next_pending(), CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                "Request timed out");
+
+  // The iterator stops at the error
+  BOOST_CHECK(executor.in_flight() == 0);
+
+  // Pages that arrived before the error are still returned
+  cass::ScopedPtr<cass::ResultResponse> result(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 0);
+  BOOST_CHECK(executor.in_flight() == 0);
+
+  BOOST_CHECK(iterator->next_page() == NULL);
+  BOOST_CHECK(iterator->error_code() == CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+  BOOST_CHECK(iterator->error_message() == "Request timed out");
+}
+
+BOOST_AUTO_TEST_CASE(session_closing)
+{
+  TestExecutor executor;
+  cass::SharedRefPtr<cass::QueryRequest> statement(new cass::QueryRequest(0));
+  cass::SharedRefPtr<cass::PageIterator> iterator(
+        create_iterator(&executor, statement.get(), 4));
+
+  iterator->start();
+  executor.set_closing();
+  finish_page(&executor, 0, true);
+
+  // No request is sent once the session is closing
+  BOOST_CHECK(executor.in_flight() == 0);
+  BOOST_CHECK(executor.request_count() == 1);
+
+  cass::ScopedPtr<cass::ResultResponse> result(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 0);
+  BOOST_CHECK(iterator->next_page() == NULL);
+  BOOST_CHECK(iterator->error_code() == CASS_ERROR_LIB_REQUEST_CANCELLED);
+}
+
+BOOST_AUTO_TEST_CASE(close)
+{
+  TestExecutor executor;
+  cass::SharedRefPtr<cass::QueryRequest> statement(new cass::QueryRequest(0));
+  cass::SharedRefPtr<cass::PageIterator> iterator(
+        create_iterator(&executor, statement.get(), 4));
+
+  iterator->start();
+  iterator->close();
+  finish_page(&executor, 0, true);
+
+  // The in-flight page is kept but nothing else is requested
+  BOOST_CHECK(executor.in_flight() == 0);
+  BOOST_CHECK(executor.request_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(page_size_bytes)
+{
+  cass::QueryRequest request("SELECT * FROM t", 0);
+  request.inc_ref();
+
+  BOOST_CHECK(cass_statement_set_paging_size_bytes(CassStatement::to(&request),
+                                                   10000, 0, 100) ==
+              CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cass_statement_set_paging_size_bytes(CassStatement::to(&request),
+                                                   10000, 100, 10) ==
+              CASS_ERROR_LIB_BAD_PARAMS);
+
+  BOOST_REQUIRE(cass_statement_set_paging_size_bytes(CassStatement::to(&request),
+                                                     10000, 10, 1000) == CASS_OK);
+  BOOST_CHECK(request.page_size() == 10);
+
+  // 100 bytes per row
+  request.update_page_size(1000, 10);
+  BOOST_CHECK(request.page_size() == 100);
+
+  // Averaged with the previous page, 550 bytes per row
+  request.update_page_size(100000, 100);
+  BOOST_CHECK(request.page_size() == 18);
+
+  // Limited by the bounds
+  request.update_page_size(10 * 1000000, 10);
+  BOOST_CHECK(request.page_size() == 10);
+  for (int i = 0; i < 32; ++i) {
+    request.update_page_size(1000, 1000);
+  }
+  BOOST_CHECK(request.page_size() == 1000);
+
+  // Empty pages don't change the page size
+  request.update_page_size(0, 0);
+  BOOST_CHECK(request.page_size() == 1000);
+}
+
+BOOST_AUTO_TEST_CASE(page_size_bytes_from_pages)
+{
+  TestExecutor executor;
+  cass::SharedRefPtr<cass::QueryRequest> statement(new cass::QueryRequest(0));
+  cass::SharedRefPtr<cass::PageIterator> iterator(
+        create_iterator(&executor, statement.get(), 1));
+  BOOST_REQUIRE(cass_statement_set_paging_size_bytes(CassStatement::to(statement.get()),
+                                                     800, 10, 1000) == CASS_OK);
+
+  iterator->start();
+  BOOST_CHECK(statement->page_size() == 10);
+
+  // Each page has a single 8 byte row ([int] size + "int" value)
+  finish_page(&executor, 0, true);
+  BOOST_CHECK(statement->page_size() == 100);
+
+  cass::ScopedPtr<cass::ResultResponse> result(iterator->next_page());
+  BOOST_CHECK(page_number(result.get()) == 0);
+  BOOST_REQUIRE(executor.in_flight() == 1);
+  finish_page(&executor, 1, false);
+  BOOST_CHECK(statement->page_size() == 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
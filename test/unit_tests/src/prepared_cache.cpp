@@ -0,0 +1,285 @@
+/*
+  Copyright (c) 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "prepared_cache.hpp"
+#include "prepared_registry.hpp"
+#include "request_handler.hpp"
+#include "test_utils.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+// Returns true if a PREPARE request had to be sent
+bool prepare(cass::PreparedCache* cache,
+             const std::string& keyspace,
+             const std::string& query,
+             const std::string& table = "t",
+             bool has_result_metadata = true) {
+  cass::SharedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  future->statement = query;
+
+  cass::SharedRefPtr<cass::ResponseFuture> request_future(
+        cache->add(keyspace, future.get()));
+  if (request_future) {
+    request_future->set_result(cass::Address(),
+                               test_utils::create_prepared_result(keyspace, table, "v",
+                                                                  has_result_metadata));
+  }
+
+  BOOST_REQUIRE(future->ready());
+  BOOST_CHECK(future->release_prepared());
+  return request_future;
+}
+
+const char* CACHE_FILE = "prepared_cache_test.bin";
+
+std::string read_file(const char* path) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+void write_file(const char* path, const std::string& contents) {
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(contents.data(), contents.size());
+}
+
+// Saves two statements to the cache file
+void save_statements() {
+  std::remove(CACHE_FILE);
+  cass::PreparedRegistry registry;
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(10));
+  BOOST_CHECK(cache->load(CACHE_FILE, 2, &registry) == 0);
+  BOOST_CHECK(prepare(cache.get(), "ks", "q1"));
+  BOOST_CHECK(prepare(cache.get(), "ks", "q2"));
+}
+
+size_t load_statements(int protocol_version = 2) {
+  cass::PreparedRegistry registry;
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(10));
+  return cache->load(CACHE_FILE, protocol_version, &registry);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(prepared_cache)
+
+BOOST_AUTO_TEST_CASE(cached)
+{
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(10));
+
+  BOOST_CHECK(prepare(cache.get(), "ks", "SELECT v FROM t WHERE k = ?"));
+  BOOST_CHECK(!prepare(cache.get(), "ks", "SELECT v FROM t WHERE k = ?"));
+
+  // The same query refers to a different table in another keyspace
+  BOOST_CHECK(prepare(cache.get(), "ks2", "SELECT v FROM t WHERE k = ?"));
+  BOOST_CHECK(!prepare(cache.get(), "ks2", "SELECT v FROM t WHERE k = ?"));
+}
+
+BOOST_AUTO_TEST_CASE(lru_eviction)
+{
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(2));
+
+  BOOST_CHECK(prepare(cache.get(), "ks", "q1"));
+  BOOST_CHECK(prepare(cache.get(), "ks", "q2"));
+
+  // Using "q1" makes "q2" the least recently used statement
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q1"));
+  BOOST_CHECK(prepare(cache.get(), "ks", "q3"));
+
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q1"));
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q3"));
+  BOOST_CHECK(prepare(cache.get(), "ks", "q2"));
+}
+
+BOOST_AUTO_TEST_CASE(in_flight_not_evicted)
+{
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(1));
+
+  cass::SharedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  future->statement = "q1";
+  cass::SharedRefPtr<cass::ResponseFuture> request_future(
+        cache->add("ks", future.get()));
+  BOOST_REQUIRE(request_future);
+
+  // The cache is over its size until "q1" is prepared
+  BOOST_CHECK(prepare(cache.get(), "ks", "q2"));
+
+  request_future->set_result(cass::Address(),
+                             test_utils::create_prepared_result("ks", "t", "v"));
+  BOOST_REQUIRE(future->ready());
+  BOOST_CHECK(future->release_prepared());
+
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q1"));
+}
+
+BOOST_AUTO_TEST_CASE(invalidate)
+{
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(10));
+
+  BOOST_CHECK(prepare(cache.get(), "ks", "q1", "t1"));
+  BOOST_CHECK(prepare(cache.get(), "ks", "q2", "t2"));
+  BOOST_CHECK(prepare(cache.get(), "ks2", "q3", "t1"));
+
+  // Results use the global table spec; its keyspace and table identify the
+  // statements to remove
+  cache->invalidate("ks", "t1");
+  BOOST_CHECK(prepare(cache.get(), "ks", "q1", "t1"));
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q2", "t2"));
+  BOOST_CHECK(!prepare(cache.get(), "ks2", "q3", "t1"));
+
+  // An empty table is every table in the keyspace
+  cache->invalidate("ks", "");
+  BOOST_CHECK(prepare(cache.get(), "ks", "q1", "t1"));
+  BOOST_CHECK(prepare(cache.get(), "ks", "q2", "t2"));
+  BOOST_CHECK(!prepare(cache.get(), "ks2", "q3", "t1"));
+}
+
+BOOST_AUTO_TEST_CASE(invalidate_without_result_metadata)
+{
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(10));
+
+  // Statements that don't return rows are matched by their bind variables
+  BOOST_CHECK(prepare(cache.get(), "ks", "INSERT", "t", false));
+  BOOST_CHECK(!prepare(cache.get(), "ks", "INSERT", "t", false));
+
+  cache->invalidate("ks", "t");
+  BOOST_CHECK(prepare(cache.get(), "ks", "INSERT", "t", false));
+}
+
+BOOST_AUTO_TEST_CASE(invalidate_in_flight)
+{
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(10));
+
+  cass::SharedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  future->statement = "q1";
+  cass::SharedRefPtr<cass::ResponseFuture> request_future(
+        cache->add("ks", future.get()));
+  BOOST_REQUIRE(request_future);
+
+  // The schema changes before the PREPARE response arrives
+  cache->invalidate("ks", "t");
+  request_future->set_result(cass::Address(),
+                             test_utils::create_prepared_result("ks", "t", "v"));
+
+  // The waiting future still gets the statement, but its result metadata
+  // isn't trusted and the statement isn't cached
+  BOOST_REQUIRE(future->ready());
+  cass::SharedRefPtr<cass::Prepared> prepared(future->release_prepared());
+  BOOST_REQUIRE(prepared);
+  BOOST_CHECK(!prepared->has_valid_result_metadata());
+
+  BOOST_CHECK(prepare(cache.get(), "ks", "q1"));
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q1"));
+}
+
+BOOST_AUTO_TEST_CASE(file)
+{
+  save_statements();
+
+  cass::PreparedRegistry registry;
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(10));
+  BOOST_CHECK(cache->load(CACHE_FILE, 2, &registry) == 2);
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q1"));
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q2"));
+
+  // Newly prepared statements are appended
+  std::string contents = read_file(CACHE_FILE);
+  BOOST_CHECK(prepare(cache.get(), "ks", "q3"));
+  BOOST_CHECK(read_file(CACHE_FILE).compare(0, contents.size(), contents) == 0);
+  BOOST_CHECK(load_statements() == 3);
+
+  std::remove(CACHE_FILE);
+}
+
+BOOST_AUTO_TEST_CASE(file_in_flight)
+{
+  save_statements();
+
+  cass::PreparedRegistry registry;
+  cass::SharedRefPtr<cass::PreparedCache> cache(new cass::PreparedCache(1));
+
+  cass::SharedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  future->statement = "q1";
+  cass::SharedRefPtr<cass::ResponseFuture> request_future(
+        cache->add("ks", future.get()));
+  BOOST_REQUIRE(request_future);
+
+  // The statement being prepared isn't replaced by the saved one so it
+  // can't be evicted before its PREPARE response arrives
+  BOOST_CHECK(cache->load(CACHE_FILE, 2, &registry) == 1);
+  BOOST_CHECK(!future->ready());
+
+  request_future->set_result(cass::Address(),
+                             test_utils::create_prepared_result("ks", "t", "v"));
+  BOOST_REQUIRE(future->ready());
+  BOOST_CHECK(future->release_prepared());
+  BOOST_CHECK(!prepare(cache.get(), "ks", "q1"));
+
+  std::remove(CACHE_FILE);
+}
+
+BOOST_AUTO_TEST_CASE(file_truncated)
+{
+  save_statements();
+
+  // A record cut short by a partial write is ignored
+  std::string contents = read_file(CACHE_FILE);
+  write_file(CACHE_FILE, contents.substr(0, contents.size() - 10));
+  BOOST_CHECK(load_statements() == 1);
+
+  std::remove(CACHE_FILE);
+}
+
+BOOST_AUTO_TEST_CASE(file_corrupt)
+{
+  save_statements();
+
+  // A record that doesn't match its checksum skips the whole file
+  std::string contents = read_file(CACHE_FILE);
+  contents[contents.size() / 2] ^= 0x1;
+  write_file(CACHE_FILE, contents);
+  BOOST_CHECK(load_statements() == 0);
+
+  // The file is started over
+  BOOST_CHECK(read_file(CACHE_FILE).size() < contents.size());
+  BOOST_CHECK(load_statements() == 0);
+
+  std::remove(CACHE_FILE);
+}
+
+BOOST_AUTO_TEST_CASE(file_protocol_version)
+{
+  save_statements();
+
+  // Result metadata is encoded differently by other protocol versions
+  BOOST_CHECK(load_statements(1) == 0);
+
+  std::remove(CACHE_FILE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "cluster.hpp"
+#include "rate_limiter.hpp"
+#include "types.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+const uint64_t MAX_DELAY = 1000000;
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(rate_limiter)
+
+BOOST_AUTO_TEST_CASE(fail)
+{
+  // 1000 requests per second with a burst of 5
+  cass::RateLimiter limiter(cass::RateLimitSettings(1000.0, 5, CASS_RATE_LIMIT_MODE_FAIL));
+
+  uint64_t now = 1000000;
+  uint64_t delay = 0;
+  for (int i = 0; i < 5; ++i) {
+    BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+    BOOST_CHECK(delay == 0);
+  }
+  BOOST_CHECK(!limiter.acquire(now, MAX_DELAY, &delay));
+
+  // A single permit is available after one interval
+  now += 1000;
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(!limiter.acquire(now, MAX_DELAY, &delay));
+
+  // The full burst is available after being idle
+  now += 1000000;
+  for (int i = 0; i < 5; ++i) {
+    BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  }
+  BOOST_CHECK(!limiter.acquire(now, MAX_DELAY, &delay));
+}
+
+BOOST_AUTO_TEST_CASE(delay)
+{
+  cass::RateLimiter limiter(cass::RateLimitSettings(1000.0, 2, CASS_RATE_LIMIT_MODE_DELAY));
+
+  uint64_t now = 1000000;
+  uint64_t delay = 0;
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(delay == 0);
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(delay == 0);
+
+  // Requests past the burst are reserved a slot in the future
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(delay == 1000);
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(delay == 2000);
+}
+
+BOOST_AUTO_TEST_CASE(max_delay)
+{
+  cass::RateLimiter limiter(cass::RateLimitSettings(1000.0, 1, CASS_RATE_LIMIT_MODE_DELAY));
+
+  uint64_t now = 1000000;
+  uint64_t delay = 0;
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK(limiter.acquire(now, 3000, &delay));
+    BOOST_CHECK(delay == i * 1000u);
+  }
+
+  // Reservations can't run further ahead than the max delay...
+  BOOST_CHECK(!limiter.acquire(now, 3000, &delay));
+
+  // ...and a failed attempt doesn't reserve a permit
+  now += 1000;
+  BOOST_CHECK(limiter.acquire(now, 3000, &delay));
+  BOOST_CHECK(delay == 3000);
+}
+
+BOOST_AUTO_TEST_CASE(release)
+{
+  cass::RateLimiter limiter(cass::RateLimitSettings(1000.0, 2, CASS_RATE_LIMIT_MODE_FAIL));
+
+  uint64_t now = 1000000;
+  uint64_t delay = 0;
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(!limiter.acquire(now, MAX_DELAY, &delay));
+
+  // A released permit can be acquired again right away
+  limiter.release();
+  BOOST_CHECK(limiter.acquire(now, MAX_DELAY, &delay));
+  BOOST_CHECK(!limiter.acquire(now, MAX_DELAY, &delay));
+}
+
+BOOST_AUTO_TEST_CASE(cluster_settings)
+{
+  CassCluster* cluster = cass_cluster_new();
+
+  BOOST_CHECK(cass_cluster_set_rate_limit(cluster, 100.0, 10,
+                                          CASS_RATE_LIMIT_MODE_DELAY) == CASS_OK);
+  BOOST_CHECK(cluster->config().rate_limit().mode == CASS_RATE_LIMIT_MODE_DELAY);
+
+  // Modes outside the enum are rejected and the settings are unchanged
+  BOOST_CHECK(cass_cluster_set_rate_limit(cluster, 200.0, 10,
+                                          static_cast<CassRateLimitMode>(3)) ==
+              CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cass_cluster_set_rate_limit(cluster, 200.0, 10,
+                                          static_cast<CassRateLimitMode>(-1)) ==
+              CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cluster->config().rate_limit().rate == 100.0);
+
+  BOOST_CHECK(cass_cluster_set_rate_limit_class(cluster, 1, 100.0, 10,
+                                                static_cast<CassRateLimitMode>(3)) ==
+              CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cluster->config().rate_limit_classes().empty());
+
+  cass_cluster_free(cluster);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
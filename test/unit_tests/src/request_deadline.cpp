@@ -0,0 +1,160 @@
+/*
+  Copyright (c) 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "config.hpp"
+#include "connection.hpp"
+#include "get_time.hpp"
+#include "handler.hpp"
+#include "io_worker.hpp"
+#include "logger.hpp"
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "session.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+class TestHandler : public cass::Handler {
+public:
+  TestHandler()
+    : error_code(CASS_OK) {}
+
+  virtual const cass::Request* request() const { return NULL; }
+  virtual void on_set(cass::ResponseMessage* response) {}
+  virtual void on_error(CassError code, const std::string& message) {
+    error_code = code;
+  }
+  virtual void on_timeout() {}
+
+  CassError error_code;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(request_deadline)
+
+BOOST_AUTO_TEST_CASE(no_deadline)
+{
+  TestHandler handler;
+  uint64_t now = cass::get_monotonic_time_ms();
+
+  BOOST_CHECK(!handler.is_past_deadline(now));
+  BOOST_CHECK(handler.remaining_time(now, 12000) == 12000);
+  BOOST_CHECK(handler.wait_time(now, 5000) == 5000);
+}
+
+BOOST_AUTO_TEST_CASE(expired_before_queueing)
+{
+  // The request timed out while waiting in the session's queue; the IO
+  // worker must fail it instead of picking a host.
+  TestHandler handler;
+  handler.set_deadline(cass::get_monotonic_time_ms() + 1);
+
+  cass::sleep_for_microseconds(5000);
+
+  BOOST_CHECK(handler.is_past_deadline(cass::get_monotonic_time_ms()));
+}
+
+BOOST_AUTO_TEST_CASE(expired_before_writing)
+{
+  // The request is still valid when it's queued but expires before a
+  // connection gets to it; it must not be written and its timer must not
+  // be started with the full request timeout.
+  TestHandler handler;
+  uint64_t now = cass::get_monotonic_time_ms();
+  handler.set_deadline(now + 100);
+
+  BOOST_CHECK(!handler.is_past_deadline(now));
+  BOOST_CHECK(handler.remaining_time(now, 12000) == 100);
+
+  BOOST_CHECK(handler.is_past_deadline(now + 100));
+  BOOST_CHECK(handler.remaining_time(now + 100, 12000) == 0);
+  BOOST_CHECK(handler.remaining_time(now + 200, 12000) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(shortened_pool_wait)
+{
+  TestHandler handler;
+  uint64_t now = cass::get_monotonic_time_ms();
+  handler.set_deadline(now + 1000);
+
+  // Waiting for a connection is capped by the connect timeout...
+  BOOST_CHECK(handler.wait_time(now, 500) == 500);
+
+  // ...but never extends past the request's deadline
+  BOOST_CHECK(handler.wait_time(now, 5000) == 1000);
+  BOOST_CHECK(handler.wait_time(now + 800, 5000) == 200);
+  BOOST_CHECK(handler.wait_time(now + 1500, 5000) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(connection_refuses_expired)
+{
+  cass::Config config;
+  cass::Logger logger(config);
+  cass::Connection* connection =
+      new cass::Connection(uv_default_loop(), &logger, config,
+                           cass::Address("127.0.0.1", 9042), "", 2);
+
+  // The request fails without taking a stream or being written
+  TestHandler handler;
+  handler.set_deadline(1);
+  BOOST_CHECK(connection->execute(&handler));
+  BOOST_CHECK(handler.error_code == CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+  BOOST_CHECK(handler.stream() == -1);
+  BOOST_CHECK(handler.state() == cass::Handler::REQUEST_STATE_NEW);
+
+  connection->close();
+  uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+}
+
+BOOST_AUTO_TEST_CASE(io_worker_refuses_expired)
+{
+  cass::Config config;
+  cass::Session session(config);
+  cass::IOWorker io_worker(&session);
+
+  cass::SharedRefPtr<cass::QueryRequest> request(
+        new cass::QueryRequest("SELECT * FROM t"));
+  cass::SharedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  cass::SharedRefPtr<cass::RequestHandler> handler(
+        new cass::RequestHandler(request.get(), future.get()));
+
+  // Retries fail a request whose deadline has passed before picking a host
+  handler->set_deadline(1);
+  io_worker.retry(handler.get(), RETRY_WITH_NEXT_HOST);
+
+  BOOST_REQUIRE(future->ready());
+  BOOST_REQUIRE(future->get_error() != NULL);
+  BOOST_CHECK(future->get_error()->code == CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+}
+
+BOOST_AUTO_TEST_CASE(monotonic)
+{
+  uint64_t prev = cass::get_monotonic_time_ms();
+  for (int i = 0; i < 100; ++i) {
+    uint64_t now = cass::get_monotonic_time_ms();
+    BOOST_CHECK(now >= prev);
+    prev = now;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,432 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "buffer_arena.hpp"
+#include "buffer_collection.hpp"
+#include "execute_request.hpp"
+#include "handler.hpp"
+#include "query_request.hpp"
+#include "test_utils.hpp"
+#include "types.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#if !defined(WIN32) && !defined(_WIN32)
+#include <sys/socket.h>
+#include <unistd.h>
+#define HAS_SOCKETPAIR
+#endif
+
+using test_utils::encode_buffers;
+
+namespace {
+
+std::string encode_single_buffer(const cass::Request* request, int version) {
+  int32_t size = request->frame_size(version);
+  BOOST_REQUIRE(size > 0);
+  std::string frame(size, '\0');
+  request->encode_frame(version, 0x00, 1, size, &frame[0]);
+  return frame;
+}
+
+// A prepared statement with two "int" values
+cass::Prepared* create_prepared() {
+  return new cass::Prepared(test_utils::create_prepared_result("ks", "t", "k,v"),
+                            "INSERT INTO ks.t (k, v) VALUES (?, ?)");
+}
+
+#ifdef HAS_SOCKETPAIR
+class WriteHandler : public cass::Handler {
+public:
+  WriteHandler(const cass::Request* request)
+    : request_(request)
+    , is_written_(false) {}
+
+  virtual const cass::Request* request() const { return request_; }
+  virtual void on_set(cass::ResponseMessage* response) {}
+  virtual void on_error(CassError code, const std::string& message) {}
+  virtual void on_timeout() {}
+
+  // Encodes the request into a frame from the arena and writes it to a
+  // socket pair
+  void encode_and_write(cass::BufferArena* arena) {
+    BOOST_REQUIRE(encode(2, 0x00, arena));
+
+    int fds[2];
+    BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    uv_pipe_t pipe;
+    uv_pipe_init(uv_default_loop(), &pipe, 0);
+    uv_pipe_open(&pipe, fds[0]);
+
+    write(reinterpret_cast<uv_stream_t*>(&pipe), this, on_write);
+    while (!is_written_) {
+      uv_run(uv_default_loop(), UV_RUN_ONCE);
+    }
+
+    uv_close(reinterpret_cast<uv_handle_t*>(&pipe), NULL);
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+    close(fds[1]);
+  }
+
+private:
+  static void on_write(cass::RequestWriter* writer) {
+    WriteHandler* handler = static_cast<WriteHandler*>(writer->data());
+    BOOST_CHECK(writer->status() == cass::RequestWriter::SUCCESS);
+    handler->is_written_ = true;
+  }
+
+  const cass::Request* request_;
+  bool is_written_;
+};
+#endif
+
+void on_release(const cass_byte_t* value, cass_size_t size, void* data) {
+  ++*static_cast<int*>(data);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(request_encoding)
+
+BOOST_AUTO_TEST_CASE(arena_reuse)
+{
+  cass::BufferArena arena;
+
+  char* block = arena.allocate(100);
+  arena.release(block, 100);
+  BOOST_CHECK(arena.cached_block_count() == 1);
+
+  // Sizes in the same class reuse the block
+  BOOST_CHECK(arena.allocate(200) == block);
+  BOOST_CHECK(arena.cached_block_count() == 0);
+  arena.release(block, 200);
+
+  // Large frames are not cached
+  char* large = arena.allocate(1024 * 1024);
+  arena.release(large, 1024 * 1024);
+  BOOST_CHECK(arena.cached_block_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(collection_encoding)
+{
+  cass::BufferCollection* collection = new cass::BufferCollection(true, 2);
+  collection->inc_ref();
+  collection->append("a", 1);
+  collection->append_int32(1);
+
+  // <size> [int] + <n> [short] + (<size> [short] + <value>) * 2
+  const char expected[] = { 0, 0, 0, 11,
+                            0, 1,
+                            0, 1, 'a',
+                            0, 4, 0, 0, 0, 1 };
+
+  std::string encoded(collection->encoded_size(2), '\0');
+  BOOST_REQUIRE(encoded.size() == sizeof(expected));
+  collection->encode(2, &encoded[0]);
+  BOOST_CHECK(encoded == std::string(expected, sizeof(expected)));
+
+  // The elements aren't copied by the buffer vector encoder
+  cass::BufferVec bufs;
+  BOOST_CHECK(collection->encode(2, &bufs) ==
+              static_cast<int>(sizeof(expected)));
+  BOOST_REQUIRE(bufs.size() == 2);
+  BOOST_CHECK(bufs[1].encoded_data() == collection->data());
+
+  collection->dec_ref();
+}
+
+BOOST_AUTO_TEST_CASE(query_matches_buffers)
+{
+  cass::BufferCollection* collection = new cass::BufferCollection(false, 2);
+  collection->inc_ref();
+  collection->append_int32(1);
+  collection->append("abc", 3);
+
+  cass::QueryRequest request("SELECT * FROM t WHERE a = ? AND b = ?", 4);
+  request.inc_ref();
+  request.bind(0, static_cast<int32_t>(42));
+  request.bind(1, CassNull());
+  request.bind(2, collection);
+  request.bind(3, cass_string_init("a string longer than the fixed buffer"));
+  request.set_page_size(100);
+  request.set_paging_state("state");
+  request.set_serial_consistency(CASS_CONSISTENCY_SERIAL);
+
+  for (int version = 1; version <= 2; ++version) {
+    BOOST_CHECK(encode_single_buffer(&request, version) ==
+                encode_buffers(&request, version));
+  }
+
+  BOOST_CHECK(request.frame_size(3) ==
+              cass::Request::ENCODE_ERROR_UNSUPPORTED_PROTOCOL);
+
+  collection->dec_ref();
+}
+
+BOOST_AUTO_TEST_CASE(collection_appended_after_bind)
+{
+  cass::BufferCollection* collection = new cass::BufferCollection(false, 1);
+  collection->inc_ref();
+  collection->append_int32(1);
+
+  cass::QueryRequest query("SELECT * FROM t WHERE a IN ?", 1);
+  query.bind(0, collection);
+  const cass::Request* request = &query;
+
+  // The encoded buffers are written after the call returns
+  cass::BufferVec bufs;
+  BOOST_REQUIRE(request->encode(2, 0x00, 1, &bufs));
+  const std::string frame = encode_buffers(request, 2);
+
+  // Enough elements to grow the collection's buffer
+  for (int i = 0; i < 1000; ++i) {
+    collection->append_int32(i);
+  }
+  BOOST_CHECK(collection->item_count() == 1001);
+
+  // The bound elements aren't changed or moved
+  std::string written;
+  for (cass::BufferVec::const_iterator it = bufs.begin(),
+       end = bufs.end(); it != end; ++it) {
+    written.append(it->encoded_data(), it->encoded_size());
+  }
+  BOOST_CHECK(written == frame);
+  BOOST_CHECK(encode_buffers(request, 2) == frame);
+
+  collection->dec_ref();
+}
+
+BOOST_AUTO_TEST_CASE(reference_is_not_copied)
+{
+  const std::string blob(1024, 'x');
+  int release_count = 0;
+
+  cass::QueryRequest copied("INSERT INTO t (k, v) VALUES (1, ?)", 1);
+  copied.inc_ref();
+  copied.bind(0, cass_bytes_init(reinterpret_cast<const cass_byte_t*>(blob.data()),
+                                 blob.size()));
+
+  {
+    cass::QueryRequest referenced("INSERT INTO t (k, v) VALUES (1, ?)", 1);
+    referenced.inc_ref();
+
+    cass::ScopedRefPtr<cass::BufferReference> reference(
+          new cass::BufferReference(reinterpret_cast<const cass_byte_t*>(blob.data()),
+                                    blob.size(), on_release, &release_count));
+    CassBytesRef ref = { reference.get() };
+    BOOST_CHECK(referenced.bind(0, ref) == CASS_OK);
+
+    BOOST_CHECK(referenced.frame_size(2) ==
+                cass::Request::ENCODE_ERROR_NO_SINGLE_BUFFER);
+
+    cass::BufferVec bufs;
+    const cass::Request* request = &referenced;
+    BOOST_REQUIRE(request->encode(2, 0x00, 1, &bufs));
+    bool has_reference = false;
+    std::string frame;
+    for (cass::BufferVec::const_iterator it = bufs.begin(),
+         end = bufs.end(); it != end; ++it) {
+      if (it->is_reference()) {
+        has_reference = true;
+        BOOST_CHECK(it->reference()->data() == blob.data());
+      }
+      frame.append(it->encoded_data(), it->encoded_size());
+    }
+    BOOST_CHECK(has_reference);
+    BOOST_CHECK(frame == encode_buffers(&copied, 2));
+    BOOST_CHECK(release_count == 0);
+  }
+
+  // Released once the statement and the encoded buffers are gone
+  BOOST_CHECK(release_count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(reset_reuses_values)
+{
+  const std::string value(100, 'x');
+
+  cass::QueryRequest request("INSERT INTO t (k, v) VALUES (?, ?)", 2);
+  request.inc_ref();
+  request.bind(0, static_cast<int32_t>(1));
+  request.bind(1, cass_string_init2(value.data(), value.size()));
+  request.set_paging_state("state");
+  const std::string first = encode_single_buffer(&request, 2);
+
+  request.reset();
+  BOOST_CHECK(request.paging_state().empty());
+  BOOST_CHECK(encode_single_buffer(&request, 2) != first);
+
+  request.bind(0, static_cast<int32_t>(1));
+  request.bind(1, cass_string_init2(value.data(), value.size()));
+  request.set_paging_state("state");
+  BOOST_CHECK(encode_single_buffer(&request, 2) == first);
+
+  // The value's storage is reused after a reset
+  cass_byte_t* output = NULL;
+  CassCustom custom = { &output, value.size() };
+  request.bind(1, custom);
+  cass_byte_t* previous = output;
+  request.reset();
+  request.bind(1, custom);
+  BOOST_CHECK(output == previous);
+}
+
+BOOST_AUTO_TEST_CASE(execute_template)
+{
+  cass::SharedRefPtr<cass::Prepared> prepared(create_prepared());
+
+  cass::ExecuteRequest request(prepared.get());
+  request.inc_ref();
+  request.bind(0, static_cast<int32_t>(1));
+  request.bind(1, static_cast<int32_t>(2));
+
+  for (int version = 1; version <= 2; ++version) {
+    // The template is encoded by the first request and copied by the second
+    BOOST_CHECK(encode_single_buffer(&request, version) ==
+                encode_buffers(&request, version));
+    BOOST_CHECK(encode_single_buffer(&request, version) ==
+                encode_buffers(&request, version));
+  }
+
+  // Changing a setting encodes the template again
+  request.set_consistency(CASS_CONSISTENCY_QUORUM);
+  request.set_page_size(10);
+  const std::string frame = encode_single_buffer(&request, 2);
+  request.set_paging_state("state"); // Not cached
+  BOOST_CHECK(encode_single_buffer(&request, 2) ==
+              encode_buffers(&request, 2));
+  request.set_paging_state("");
+  BOOST_CHECK(encode_buffers(&request, 2) == frame);
+
+  // The skip metadata flag is removed after the metadata becomes stale
+  BOOST_CHECK(request.can_reuse_frame());
+  prepared->invalidate_result_metadata();
+  BOOST_CHECK(!request.can_reuse_frame());
+  BOOST_CHECK(encode_single_buffer(&request, 2) != frame);
+  BOOST_CHECK(encode_single_buffer(&request, 2) ==
+              encode_buffers(&request, 2));
+}
+
+#ifdef HAS_SOCKETPAIR
+BOOST_AUTO_TEST_CASE(frame_released_after_write)
+{
+  cass::BufferArena arena;
+
+  {
+    cass::QueryRequest request;
+    request.inc_ref();
+    request.set_query("SELECT * FROM t");
+
+    // Frames that won't be sent again go back to the arena right away
+    WriteHandler handler(&request);
+    handler.inc_ref();
+    handler.encode_and_write(&arena);
+    BOOST_CHECK(arena.cached_block_count() == 1);
+  }
+
+  {
+    cass::SharedRefPtr<cass::Prepared> prepared(create_prepared());
+    cass::ExecuteRequest request(prepared.get());
+    request.inc_ref();
+    request.bind(0, static_cast<int32_t>(1));
+    request.bind(1, static_cast<int32_t>(2));
+
+    // Executions from the template keep their frame for a retry until the
+    // handler is done
+    BOOST_CHECK(request.keeps_frame());
+    {
+      WriteHandler handler(&request);
+      handler.inc_ref();
+      handler.encode_and_write(&arena);
+      BOOST_CHECK(arena.cached_block_count() == 0);
+    }
+    BOOST_CHECK(arena.cached_block_count() == 1);
+
+    request.set_paging_state("state");
+    BOOST_CHECK(!request.keeps_frame());
+  }
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(frozen_body_is_shared)
+{
+  cass::QueryRequest request("SELECT * FROM system.local WHERE key = ?", 1);
+  request.inc_ref();
+  request.bind(0, cass_string_init("local"));
+
+  const std::string expected = encode_buffers(&request, 2);
+  request.freeze();
+  BOOST_CHECK(request.frame_size(2) ==
+              cass::Request::ENCODE_ERROR_NO_SINGLE_BUFFER);
+  BOOST_CHECK(encode_buffers(&request, 2) == expected);
+
+  const cass::Request* frozen = &request;
+  cass::BufferVec first, second;
+  BOOST_REQUIRE(frozen->encode(2, 0x00, 1, &first));
+  BOOST_REQUIRE(frozen->encode(2, 0x00, 2, &second));
+  BOOST_REQUIRE(first.size() == 2 && second.size() == 2);
+  BOOST_CHECK(first[0].data()[2] == 1 && second[0].data()[2] == 2);
+  BOOST_CHECK(first[1].data() == second[1].data());
+
+  // Changes are only sent after the statement is reset
+  request.reset();
+  BOOST_CHECK(!request.is_frozen());
+  BOOST_CHECK(encode_buffers(&request, 2) != expected);
+}
+
+BOOST_AUTO_TEST_CASE(bind_by_handle)
+{
+  cass::SharedRefPtr<cass::Prepared> prepared(create_prepared());
+  const CassPrepared* cass_prepared = CassPrepared::to(prepared.get());
+
+  CassColumnHandle k, v;
+  BOOST_REQUIRE(cass_prepared_column_index(cass_prepared, "K", &k) == CASS_OK);
+  BOOST_REQUIRE(cass_prepared_column_index(cass_prepared, "v", &v) == CASS_OK);
+  BOOST_CHECK(cass_prepared_column_index(cass_prepared, "\"K\"", &k) ==
+              CASS_ERROR_NAME_DOES_NOT_EXIST);
+
+  CassStatement* by_handle = cass_prepared_bind(cass_prepared);
+  BOOST_REQUIRE(cass_statement_bind_int32_by_handle(by_handle, k, 1) == CASS_OK);
+  BOOST_REQUIRE(cass_statement_bind_int32_by_handle(by_handle, v, 2) == CASS_OK);
+  BOOST_CHECK(cass_statement_bind_int64_by_handle(by_handle, v, 2) ==
+              CASS_ERROR_LIB_INVALID_VALUE_TYPE);
+
+  CassStatement* by_index = cass_prepared_bind(cass_prepared);
+  cass_statement_bind_int32(by_index, 0, 1);
+  cass_statement_bind_int32(by_index, 1, 2);
+
+  BOOST_CHECK(encode_buffers(by_handle->from(), 2) ==
+              encode_buffers(by_index->from(), 2));
+
+  // Handles from another prepared statement are rejected
+  cass::SharedRefPtr<cass::Prepared> other(create_prepared());
+  CassStatement* other_statement = cass_prepared_bind(CassPrepared::to(other.get()));
+  BOOST_CHECK(cass_statement_bind_int32_by_handle(other_statement, k, 1) ==
+              CASS_ERROR_LIB_INVALID_COLUMN_HANDLE);
+
+  cass_statement_free(other_statement);
+  cass_statement_free(by_index);
+  cass_statement_free(by_handle);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,430 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "handler.hpp"
+#include "metadata_cache.hpp"
+#include "query_request.hpp"
+#include "result_response.hpp"
+#include "scatter_gather.hpp"
+#include "serialization.hpp"
+#include "test_utils.hpp"
+#include "types.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace test_utils;
+
+namespace {
+
+// Rows of (text, int, bigint) where every third "int" is null
+void append_rows_body(std::string* body, int row_count) {
+  append_int32(body, CASS_RESULT_KIND_ROWS);
+  append_metadata_header(body, "ks", "t", 3);
+  append_column(body, "name", CASS_VALUE_TYPE_VARCHAR);
+  append_column(body, "i", CASS_VALUE_TYPE_INT);
+  append_column(body, "l", CASS_VALUE_TYPE_BIGINT);
+  append_int32(body, row_count);
+
+  for (int i = 0; i < row_count; ++i) {
+    std::string name(i, 'x'); // Variable length values are skipped
+    append_int32(body, name.size());
+    body->append(name);
+    if (i % 3 == 0) {
+      append_int32(body, -1);
+    } else {
+      append_int32(body, sizeof(int32_t));
+      append_int32(body, i);
+    }
+    append_int32(body, sizeof(cass_int64_t));
+    append_int64(body, -i);
+  }
+}
+
+cass::ResultResponse* create_result(std::string* body, int row_count,
+                                   cass::MetadataCache* cache = NULL) {
+  append_rows_body(body, row_count);
+
+  cass::ResultResponse* result = new cass::ResultResponse();
+  result->set_metadata_cache(cache);
+  BOOST_REQUIRE(result->decode(2, &(*body)[0], body->size()));
+  result->decode_first_row();
+  return result;
+}
+
+void on_row(const CassRow* row, void* data) {
+  std::vector<cass_int64_t>* values = static_cast<std::vector<cass_int64_t>*>(data);
+  cass_int64_t value;
+  BOOST_REQUIRE(cass_value_get_int64(cass_row_get_column_by_name(row, "l"),
+                                     &value) == CASS_OK);
+  values->push_back(value);
+}
+
+std::string create_frame(int8_t opcode, const std::string& body) {
+  std::string frame;
+  frame.push_back(static_cast<char>(0x82));
+  frame.push_back(0); // Flags
+  frame.push_back(1); // Stream
+  frame.push_back(opcode);
+  append_int32(&frame, body.size());
+  frame.append(body);
+  return frame;
+}
+
+// A request that's been written and is waiting for its response
+class StreamHandler : public cass::Handler {
+public:
+  StreamHandler(const cass::Request* request)
+    : request_(request)
+    , is_cancelled_(false) {
+    set_state(REQUEST_STATE_WRITING);
+    set_state(REQUEST_STATE_READING);
+  }
+
+  virtual const cass::Request* request() const { return request_; }
+  virtual bool is_cancelled() const { return is_cancelled_; }
+  virtual void on_set(cass::ResponseMessage* response) {}
+  virtual void on_error(CassError code, const std::string& message) {}
+  virtual void on_timeout() {}
+
+  void cancel() { is_cancelled_ = true; }
+
+private:
+  const cass::Request* request_;
+  bool is_cancelled_;
+};
+
+// Decodes only the header of a frame and returns true if the handler
+// starts streaming its rows
+bool starts_streaming(StreamHandler* handler, int8_t opcode) {
+  std::string body;
+  append_rows_body(&body, 1);
+  std::string frame = create_frame(opcode, body);
+
+  cass::ResponseMessage response;
+  BOOST_REQUIRE(response.decode(2, &frame[0], CASS_HEADER_SIZE_V1_AND_V2) ==
+                CASS_HEADER_SIZE_V1_AND_V2);
+  handler->maybe_stream_rows(&response);
+  return response.is_streaming_rows();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(result_response)
+
+BOOST_AUTO_TEST_CASE(get_column)
+{
+  const int row_count = 10;
+  std::string body;
+  cass::ScopedPtr<cass::ResultResponse> result(create_result(&body, row_count));
+  const CassResult* cass_result = CassResult::to(result.get());
+
+  cass_int32_t ints[row_count];
+  cass_uint8_t nulls[(row_count + 7) / 8];
+  BOOST_REQUIRE(cass_result_get_column_int32(cass_result, 1, ints, row_count,
+                                             nulls) == CASS_OK);
+  for (int i = 0; i < row_count; ++i) {
+    bool is_null = (nulls[i / 8] & (1 << (i % 8))) != 0;
+    BOOST_CHECK(is_null == (i % 3 == 0));
+    BOOST_CHECK(ints[i] == (is_null ? 0 : i));
+  }
+
+  cass_int64_t longs[row_count];
+  BOOST_REQUIRE(cass_result_get_column_int64(cass_result, 2, longs, row_count,
+                                             NULL) == CASS_OK);
+  for (int i = 0; i < row_count; ++i) {
+    BOOST_CHECK(longs[i] == -i);
+  }
+
+  // Only the requested number of rows are decoded
+  cass_int64_t first[2] = { 1, 1 };
+  BOOST_CHECK(cass_result_get_column_int64(cass_result, 2, first, 1,
+                                           NULL) == CASS_OK);
+  BOOST_CHECK(first[0] == 0 && first[1] == 1);
+
+  BOOST_CHECK(cass_result_get_column_int64(cass_result, 1, longs, row_count,
+                                           NULL) == CASS_ERROR_LIB_INVALID_VALUE_TYPE);
+  BOOST_CHECK(cass_result_get_column_int32(cass_result, 3, ints, row_count,
+                                           NULL) == CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS);
+}
+
+BOOST_AUTO_TEST_CASE(get_column_empty)
+{
+  // An empty value, a value of the wrong size and a valid value
+  std::string body;
+  append_int32(&body, CASS_RESULT_KIND_ROWS);
+  append_metadata(&body, "ks", "t", "v");
+  append_int32(&body, 3);
+  append_int32(&body, 0);
+  append_int32(&body, sizeof(cass_int64_t));
+  append_int64(&body, 1);
+  append_int32(&body, sizeof(int32_t));
+  append_int32(&body, 2);
+  cass::ScopedPtr<cass::ResultResponse> result(decode_result(body));
+
+  cass_int32_t ints[3] = { -1, -1, -1 };
+  cass_uint8_t nulls = 0;
+  BOOST_REQUIRE(cass_result_get_column_int32(CassResult::to(result.get()), 0,
+                                             ints, 3, &nulls) == CASS_OK);
+  BOOST_CHECK(ints[0] == 0 && ints[1] == 0 && ints[2] == 2);
+  BOOST_CHECK(nulls == 0x3);
+}
+
+BOOST_AUTO_TEST_CASE(get_column_truncated)
+{
+  // The row count is larger than the rows in the body
+  std::string body;
+  append_int32(&body, CASS_RESULT_KIND_ROWS);
+  append_metadata(&body, "ks", "t", "v");
+  append_int32(&body, 3);
+  append_int32(&body, sizeof(int32_t));
+  append_int32(&body, 1);
+  append_int32(&body, 100);
+  cass::ScopedPtr<cass::ResultResponse> result(decode_result(body));
+
+  cass_int32_t ints[3];
+  BOOST_CHECK(cass_result_get_column_int32(CassResult::to(result.get()), 0,
+                                           ints, 3, NULL) ==
+              CASS_ERROR_LIB_UNEXPECTED_RESPONSE);
+}
+
+BOOST_AUTO_TEST_CASE(row_at)
+{
+  const int row_count = 10;
+  std::string body;
+  cass::ScopedPtr<cass::ResultResponse> result(create_result(&body, row_count));
+  const CassResult* cass_result = CassResult::to(result.get());
+
+  // Access the rows out of order
+  for (int i = row_count - 1; i >= 0; --i) {
+    const CassRow* row = cass_result_row_at(cass_result, i);
+    BOOST_REQUIRE(row != NULL);
+
+    CassString name;
+    BOOST_REQUIRE(cass_value_get_string(cass_row_get_column(row, 0),
+                                        &name) == CASS_OK);
+    BOOST_CHECK(name.length == static_cast<cass_size_t>(i));
+
+    const CassValue* value = cass_row_get_column(row, 1);
+    BOOST_CHECK(cass_value_is_null(value) == (i % 3 == 0));
+
+    cass_int64_t l;
+    BOOST_REQUIRE(cass_value_get_int64(cass_row_get_column(row, 2),
+                                       &l) == CASS_OK);
+    BOOST_CHECK(l == -i);
+  }
+
+  // Rows are stable across calls
+  BOOST_CHECK(cass_result_row_at(cass_result, 5) ==
+              cass_result_row_at(cass_result, 5));
+  BOOST_CHECK(cass_result_row_at(cass_result, row_count) == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(column_handle)
+{
+  std::string body;
+  cass::ScopedPtr<cass::ResultResponse> result(create_result(&body, 3));
+  const CassResult* cass_result = CassResult::to(result.get());
+
+  CassColumnHandle handle;
+  BOOST_REQUIRE(cass_result_column_index(cass_result, "L", &handle) == CASS_OK);
+  BOOST_CHECK(cass_result_column_index(cass_result, "x", &handle) ==
+              CASS_ERROR_NAME_DOES_NOT_EXIST);
+
+  for (cass_size_t i = 0; i < 3; ++i) {
+    const CassRow* row = cass_result_row_at(cass_result, i);
+    BOOST_CHECK(cass_row_get_column_by_handle(row, handle) ==
+                cass_row_get_column_by_name(row, "l"));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(stream_rows)
+{
+  const int row_count = 50;
+  std::string body;
+  append_rows_body(&body, row_count);
+  std::string frame = create_frame(CQL_OPCODE_RESULT, body);
+
+  cass::ResponseMessage response;
+  std::vector<cass_int64_t> values;
+
+  // Feed the frame in small pieces like a slow connection
+  const size_t chunk_size = 7;
+  size_t pos = 0;
+  while (pos < frame.size()) {
+    size_t size = std::min(chunk_size, frame.size() - pos);
+    int consumed = response.decode(2, &frame[pos], size);
+    BOOST_REQUIRE(consumed > 0);
+    pos += consumed;
+    if (response.is_header_received() && !response.is_streaming_rows() &&
+        !response.is_body_ready()) {
+      response.stream_rows(NULL, on_row, &values);
+    }
+  }
+
+  BOOST_REQUIRE(response.is_body_ready());
+  BOOST_REQUIRE(values.size() == static_cast<size_t>(row_count));
+  for (int i = 0; i < row_count; ++i) {
+    BOOST_CHECK(values[i] == -i);
+  }
+
+  // Only the metadata is kept in the result
+  cass::ResultResponse* result =
+      static_cast<cass::ResultResponse*>(response.response_body().get());
+  BOOST_CHECK(result->row_count() == 0);
+  BOOST_CHECK(result->column_count() == 3);
+  BOOST_CHECK(result->buffer_size() < body.size());
+}
+
+BOOST_AUTO_TEST_CASE(stream_rows_gating)
+{
+  std::vector<cass_int64_t> values;
+  cass::QueryRequest request("SELECT * FROM ks.t");
+
+  // Only requests with a row callback stream their rows
+  StreamHandler without_callback(&request);
+  BOOST_CHECK(!starts_streaming(&without_callback, CQL_OPCODE_RESULT));
+
+  request.set_row_callback(on_row, &values);
+  StreamHandler handler(&request);
+  BOOST_CHECK(starts_streaming(&handler, CQL_OPCODE_RESULT));
+  BOOST_CHECK(!starts_streaming(&handler, CQL_OPCODE_ERROR));
+
+  StreamHandler cancelled(&request);
+  cancelled.cancel();
+  BOOST_CHECK(!starts_streaming(&cancelled, CQL_OPCODE_RESULT));
+
+  StreamHandler timed_out(&request);
+  timed_out.set_state(cass::Handler::REQUEST_STATE_TIMEOUT);
+  BOOST_CHECK(!starts_streaming(&timed_out, CQL_OPCODE_RESULT));
+
+  BOOST_CHECK(values.empty());
+}
+
+BOOST_AUTO_TEST_CASE(stream_rows_stopped)
+{
+  const int row_count = 50;
+  std::string body;
+  append_rows_body(&body, row_count);
+  std::string frame = create_frame(CQL_OPCODE_RESULT, body);
+
+  for (int i = 0; i < 2; ++i) {
+    bool is_timeout = (i == 0);
+    std::vector<cass_int64_t> values;
+    cass::QueryRequest request("SELECT * FROM ks.t");
+    request.set_row_callback(on_row, &values);
+    StreamHandler handler(&request);
+
+    // Fed like Connection::consume(), the handler checks the response
+    // before each piece of the frame
+    cass::ResponseMessage response;
+    const size_t chunk_size = 7;
+    size_t stopped_at_row = 0;
+    size_t pos = 0;
+    while (pos < frame.size()) {
+      if (pos >= frame.size() / 2 && stopped_at_row == 0) {
+        stopped_at_row = values.size();
+        if (is_timeout) {
+          handler.set_state(cass::Handler::REQUEST_STATE_TIMEOUT);
+        } else {
+          handler.cancel();
+        }
+      }
+      handler.maybe_stream_rows(&response);
+      size_t size = std::min(chunk_size, frame.size() - pos);
+      int consumed = response.decode(2, &frame[pos], size);
+      BOOST_REQUIRE(consumed > 0);
+      pos += consumed;
+    }
+
+    // The rest of the body is skipped without calling the row callback
+    BOOST_REQUIRE(response.is_body_ready());
+    BOOST_CHECK(response.is_body_discarded());
+    BOOST_CHECK(stopped_at_row > 0);
+    BOOST_CHECK(values.size() == stopped_at_row);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(metadata_cache)
+{
+  cass::MetadataCache cache;
+
+  std::string body1;
+  cass::ScopedPtr<cass::ResultResponse> result1(create_result(&body1, 1, &cache));
+  std::string body2;
+  cass::ScopedPtr<cass::ResultResponse> result2(create_result(&body2, 5, &cache));
+
+  // Results with the same column specs share their metadata
+  BOOST_CHECK(result1->metadata().get() == result2->metadata().get());
+
+  // The shared metadata doesn't reference the first result's buffer
+  cass::Metadata* metadata = result1->metadata().get();
+  result1.reset();
+  body1.clear();
+  cass::Metadata::IndexVec indices;
+  BOOST_REQUIRE(metadata->get("L", &indices) == 1);
+  BOOST_CHECK(indices[0] == 2);
+
+  const cass::ColumnDefinition& def = metadata->get(0);
+  BOOST_CHECK(std::string(def.keyspace, def.keyspace_size) == "ks");
+  BOOST_CHECK(std::string(def.table, def.table_size) == "t");
+  BOOST_CHECK(result2->keyspace() == "ks");
+
+  cass_int64_t l;
+  BOOST_REQUIRE(cass_value_get_int64(
+                  cass_row_get_column(CassRow::to(result2->row_at(4)), 2),
+                  &l) == CASS_OK);
+  BOOST_CHECK(l == -4);
+
+  // Results without a cache get their own metadata
+  std::string body3;
+  cass::ScopedPtr<cass::ResultResponse> result3(create_result(&body3, 1));
+  BOOST_CHECK(result3->metadata().get() != result2->metadata().get());
+}
+
+BOOST_AUTO_TEST_CASE(multiple_result_iterator)
+{
+  std::string bodies[3];
+  cass::SharedRefPtr<cass::ScatterFuture> future(new cass::ScatterFuture(4));
+  future->set_result(0, create_result(&bodies[0], 3));
+  future->set_result(1, create_result(&bodies[1], 0));
+  // No result for the third key
+  future->set_result(3, create_result(&bodies[2], 2));
+  future->set();
+
+  CassIterator* iterator = cass_iterator_from_future(CassFuture::to(future.get()));
+  BOOST_REQUIRE(iterator != NULL);
+
+  std::vector<cass_int64_t> values;
+  while (cass_iterator_next(iterator)) {
+    on_row(cass_iterator_get_row(iterator), &values);
+  }
+  cass_iterator_free(iterator);
+
+  const cass_int64_t expected[] = { 0, -1, -2, 0, -1 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(),
+                                expected, expected + 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
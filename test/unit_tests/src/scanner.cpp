@@ -0,0 +1,187 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "scanner.hpp"
+#include "test_utils.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const int64_t MIN_TOKEN = std::numeric_limits<int64_t>::min();
+const int64_t MAX_TOKEN = std::numeric_limits<int64_t>::max();
+
+// The ranges must cover the whole ring, (min, max], without gaps or overlaps
+void check_ring_covered(const cass::Scanner::TokenRangeVec& ranges) {
+  BOOST_REQUIRE(!ranges.empty());
+
+  std::vector<std::pair<int64_t, int64_t> > sorted;
+  for (cass::Scanner::TokenRangeVec::const_iterator it = ranges.begin(),
+       end = ranges.end(); it != end; ++it) {
+    BOOST_CHECK(it->start < it->end);
+    sorted.push_back(std::make_pair(it->start, it->end));
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  BOOST_CHECK(sorted.front().first == MIN_TOKEN);
+  BOOST_CHECK(sorted.back().second == MAX_TOKEN);
+  for (size_t i = 1; i < sorted.size(); ++i) {
+    BOOST_CHECK(sorted[i - 1].second == sorted[i].first);
+  }
+}
+
+cass::Scanner* create_scanner(test_utils::TestExecutor* executor,
+                              size_t split_count, size_t concurrency) {
+  cass::Scanner* scanner = new cass::Scanner(executor, "SELECT v FROM ks.t", "k",
+                                             split_count, concurrency, 0,
+                                             NULL, NULL);
+  scanner->inc_ref();
+  return scanner;
+}
+
+} // namespace
+
+using test_utils::TestExecutor;
+
+BOOST_AUTO_TEST_SUITE(scanner)
+
+BOOST_AUTO_TEST_CASE(single_token)
+{
+  cass::Address address("127.0.0.1", 9042);
+  cass::TokenMap tokens;
+  tokens[0] = address;
+
+  cass::Scanner::TokenRangeVec ranges;
+  cass::Scanner::build_ranges(tokens, 1, &ranges);
+
+  // (0, max] and (min, 0]
+  BOOST_REQUIRE(ranges.size() == 2);
+  BOOST_CHECK(ranges[0].start == 0 && ranges[0].end == MAX_TOKEN);
+  BOOST_CHECK(ranges[1].start == MIN_TOKEN && ranges[1].end == 0);
+  BOOST_CHECK(ranges[0].address.compare(address) == 0);
+  BOOST_CHECK(ranges[1].address.compare(address) == 0);
+  check_ring_covered(ranges);
+}
+
+BOOST_AUTO_TEST_CASE(split_ranges)
+{
+  cass::Address address1("127.0.0.1", 9042);
+  cass::Address address2("127.0.0.2", 9042);
+  cass::Address address3("127.0.0.3", 9042);
+
+  cass::TokenMap tokens;
+  tokens[-3074457345618258603LL] = address1;
+  tokens[3074457345618258602LL] = address2;
+  tokens[MAX_TOKEN] = address3;
+
+  for (size_t split_count = 1; split_count <= 7; ++split_count) {
+    cass::Scanner::TokenRangeVec ranges;
+    cass::Scanner::build_ranges(tokens, split_count, &ranges);
+
+    // The wrapping range (max, max] is empty
+    BOOST_CHECK(ranges.size() == 3 * split_count);
+    check_ring_covered(ranges);
+
+    // Each range is owned by the host of its end token
+    for (cass::Scanner::TokenRangeVec::const_iterator it = ranges.begin(),
+         end = ranges.end(); it != end; ++it) {
+      cass::TokenMap::const_iterator owner = tokens.lower_bound(it->end);
+      BOOST_REQUIRE(owner != tokens.end());
+      BOOST_CHECK(it->address.compare(owner->second) == 0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(narrow_ranges)
+{
+  cass::Address address("127.0.0.1", 9042);
+  cass::TokenMap tokens;
+  tokens[MIN_TOKEN + 2] = address;
+  tokens[MIN_TOKEN + 3] = address;
+
+  // Ranges aren't split into more pieces than they have tokens
+  cass::Scanner::TokenRangeVec ranges;
+  cass::Scanner::build_ranges(tokens, 4, &ranges);
+  BOOST_CHECK(ranges.size() == 4 + 2 + 1);
+  check_ring_covered(ranges);
+}
+
+BOOST_AUTO_TEST_CASE(scan)
+{
+  cass::Address address("127.0.0.1", 9042);
+  cass::TokenMap tokens;
+  tokens[0] = address;
+
+  // Two ranges, each split in two
+  TestExecutor executor;
+  cass::Scanner* scanner = create_scanner(&executor, 2, 2);
+  scanner->start(tokens);
+  BOOST_REQUIRE(executor.request_count() == 2);
+
+  // The next page of a range is read before starting a new range
+  executor.finish(0, test_utils::create_int_result(1, "page2"));
+  BOOST_REQUIRE(executor.request_count() == 3);
+  BOOST_CHECK(executor.request(2) == executor.request(0));
+  BOOST_CHECK(executor.paging_state(2) == "page2");
+
+  while (executor.in_flight() > 0) {
+    BOOST_CHECK(!scanner->future()->ready());
+    executor.finish(executor.next_pending(), test_utils::create_int_result(1));
+  }
+
+  BOOST_CHECK(executor.request_count() == 4 + 1);
+  BOOST_CHECK(executor.max_in_flight() == 2);
+  for (size_t i = 0; i < executor.request_count(); ++i) {
+    BOOST_CHECK(executor.request(i)->preferred_address() == address);
+  }
+  BOOST_REQUIRE(scanner->future()->ready());
+  BOOST_CHECK(!scanner->future()->is_error());
+
+  scanner->dec_ref();
+}
+
+BOOST_AUTO_TEST_CASE(session_closing)
+{
+  cass::TokenMap tokens;
+  tokens[0] = cass::Address("127.0.0.1", 9042);
+
+  TestExecutor executor;
+  cass::Scanner* scanner = create_scanner(&executor, 2, 1);
+  scanner->start(tokens);
+  BOOST_REQUIRE(executor.request_count() == 1);
+
+  // No more requests are sent once the session is closing
+  executor.set_closing();
+  executor.finish(0, test_utils::create_int_result(1, "page2"));
+  BOOST_CHECK(executor.request_count() == 1);
+
+  BOOST_REQUIRE(scanner->future()->ready());
+  cass::Future::Error* error = scanner->future()->get_error();
+  BOOST_REQUIRE(error != NULL);
+  BOOST_CHECK(error->code == CASS_ERROR_LIB_REQUEST_CANCELLED);
+
+  scanner->dec_ref();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,229 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "execute_request.hpp"
+#include "prepared.hpp"
+#include "scatter_gather.hpp"
+#include "test_utils.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using test_utils::TestExecutor;
+
+namespace {
+
+// The n-th request sent is for the n-th key
+class Scatter {
+public:
+  Scatter(size_t key_count)
+    : prepared(new cass::Prepared(test_utils::create_prepared_result("ks", "t",
+                                                                     "k"),
+                                  "SELECT v FROM ks.t WHERE k = ?"))
+    , statement(new cass::ExecuteRequest(prepared.get()))
+    , keys(new cass::BufferCollection(false, key_count)) {
+    for (size_t i = 0; i < key_count; ++i) {
+      keys->append_int32(i);
+    }
+  }
+
+  cass::ScatterFuture* start(size_t concurrency, bool preserve_order,
+                             size_t key_index = 0) {
+    scatter.reset(new cass::ScatterGather(&executor, statement.get(),
+                                          key_index, keys.get(),
+                                          concurrency, preserve_order));
+    scatter->start();
+    return static_cast<cass::ScatterFuture*>(scatter->future());
+  }
+
+  TestExecutor executor;
+  cass::SharedRefPtr<cass::Prepared> prepared;
+  cass::SharedRefPtr<cass::ExecuteRequest> statement;
+  cass::SharedRefPtr<cass::BufferCollection> keys;
+  cass::SharedRefPtr<cass::ScatterGather> scatter;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(scatter_gather)
+
+BOOST_AUTO_TEST_CASE(concurrency)
+{
+  Scatter test(5);
+  cass::ScatterFuture* future = test.start(2, true);
+
+  BOOST_CHECK(test.executor.request_count() == 2);
+
+  // A new request is sent as each one finishes
+  test.executor.finish(1, test_utils::create_int_result(10));
+  BOOST_CHECK(test.executor.request_count() == 3);
+  test.executor.finish(0, test_utils::create_int_result(0));
+  test.executor.finish(2, test_utils::create_int_result(20));
+  BOOST_CHECK(!future->ready());
+  test.executor.finish(4, test_utils::create_int_result(40));
+  test.executor.finish(3, test_utils::create_int_result(30));
+
+  BOOST_CHECK(test.executor.request_count() == 5);
+  BOOST_CHECK(test.executor.max_in_flight() == 2);
+  BOOST_REQUIRE(future->ready());
+  BOOST_CHECK(!future->is_error());
+  BOOST_CHECK(future->results().size() == 5);
+}
+
+BOOST_AUTO_TEST_CASE(preserve_order)
+{
+  for (int i = 0; i < 2; ++i) {
+    bool preserve_order = (i == 0);
+    Scatter test(3);
+    cass::ScatterFuture* future = test.start(3, preserve_order);
+    BOOST_REQUIRE(test.executor.request_count() == 3);
+
+    test.executor.finish(2, test_utils::create_int_result(20));
+    test.executor.finish(0, test_utils::create_int_result(0));
+    test.executor.finish(1, test_utils::create_int_result(10));
+
+    BOOST_REQUIRE(future->ready() && !future->is_error());
+    const cass::ScatterFuture::ResultVec& results = future->results();
+    BOOST_REQUIRE(results.size() == 3);
+    if (preserve_order) {
+      // In the order of the keys
+      BOOST_CHECK(test_utils::int_result_value(results[0]) == 0);
+      BOOST_CHECK(test_utils::int_result_value(results[1]) == 10);
+      BOOST_CHECK(test_utils::int_result_value(results[2]) == 20);
+    } else {
+      // In the order the results arrived
+      BOOST_CHECK(test_utils::int_result_value(results[0]) == 20);
+      BOOST_CHECK(test_utils::int_result_value(results[1]) == 0);
+      BOOST_CHECK(test_utils::int_result_value(results[2]) == 10);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(keys_copied)
+{
+  Scatter test(3);
+  test.start(1, true);
+
+  // The keys can be changed and freed once the scatter has started
+  for (int i = 0; i < 1000; ++i) {
+    test.keys->append_int32(-1);
+  }
+  test.keys.reset();
+
+  for (size_t i = 0; i < 3; ++i) {
+    BOOST_REQUIRE(test.executor.request_count() == i + 1);
+
+    char key[sizeof(int32_t)];
+    cass::encode_int32(key, i);
+    cass::ExecuteRequest expected(test.prepared.get());
+    expected.bind(0, cass_bytes_init(reinterpret_cast<const cass_byte_t*>(key),
+                                     sizeof(key)));
+    BOOST_CHECK(test_utils::encode_buffers(test.executor.request(i), 2) ==
+                test_utils::encode_buffers(&expected, 2));
+
+    test.executor.finish(i, test_utils::create_int_result(i));
+  }
+  BOOST_CHECK(test.executor.request_count() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(error)
+{
+  Scatter test(4);
+  cass::ScatterFuture* future = test.start(2, true);
+
+  // No new requests are sent after an error
+  test.executor.fail(0, CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+  BOOST_CHECK(test.executor.request_count() == 2);
+
+  // The future is set once the requests in-flight have finished
+  BOOST_CHECK(!future->ready());
+  test.executor.finish(1, test_utils::create_int_result(10));
+  BOOST_CHECK(test.executor.request_count() == 2);
+
+  BOOST_REQUIRE(future->ready());
+  BOOST_REQUIRE(future->is_error());
+  BOOST_CHECK(future->get_error()->code == CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+}
+
+BOOST_AUTO_TEST_CASE(bind_error)
+{
+  // The prepared statement only has a single value
+  Scatter test(3);
+  cass::ScatterFuture* future = test.start(2, true, 1);
+
+  BOOST_CHECK(test.executor.request_count() == 0);
+  BOOST_REQUIRE(future->ready());
+  BOOST_REQUIRE(future->is_error());
+  BOOST_CHECK(future->get_error()->code == CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS);
+  BOOST_CHECK(future->get_error()->message == "Unable to bind the key");
+}
+
+BOOST_AUTO_TEST_CASE(empty_keys)
+{
+  Scatter test(0);
+  cass::ScatterFuture* future = test.start(2, true);
+
+  BOOST_CHECK(test.executor.request_count() == 0);
+  BOOST_REQUIRE(future->ready());
+  BOOST_CHECK(!future->is_error());
+  BOOST_CHECK(future->results().empty());
+}
+
+BOOST_AUTO_TEST_CASE(session_closing)
+{
+  Scatter test(4);
+  cass::ScatterFuture* future = test.start(2, true);
+
+  // No requests are sent once the session is closing
+  test.executor.set_closing();
+  test.executor.finish(0, test_utils::create_int_result(0));
+  BOOST_CHECK(test.executor.request_count() == 2);
+
+  test.executor.finish(1, test_utils::create_int_result(10));
+  BOOST_REQUIRE(future->ready());
+  BOOST_REQUIRE(future->is_error());
+  BOOST_CHECK(future->get_error()->code == CASS_ERROR_LIB_REQUEST_CANCELLED);
+}
+
+BOOST_AUTO_TEST_CASE(inline_callback_mode)
+{
+  Scatter test(3);
+  test.executor.set_callback_mode(CASS_CALLBACK_MODE_INLINE, uv_default_loop());
+  cass::ScatterFuture* future = test.start(1, true);
+  BOOST_REQUIRE(test.executor.request_count() == 1);
+
+  // This thread plays the IO thread. The next key's request isn't sent
+  // from it, the callback runs on the work queue instead.
+  unsigned long io_thread = static_cast<unsigned long>(uv_thread_self());
+  for (size_t i = 0; i < 3; ++i) {
+    test.executor.finish(i, test_utils::create_int_result(i * 10));
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+  }
+
+  BOOST_REQUIRE(test.executor.request_count() == 3);
+  for (size_t i = 1; i < 3; ++i) {
+    BOOST_CHECK(test.executor.thread(i) != io_thread);
+  }
+  BOOST_REQUIRE(future->ready());
+  BOOST_CHECK(!future->is_error());
+  BOOST_CHECK(test_utils::int_result_value(future->results()[2]) == 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
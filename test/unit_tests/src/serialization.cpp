@@ -0,0 +1,207 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "serialization.hpp"
+#include "types.hpp"
+#include "value.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Lays out values the way collection items are encoded: [short size][value]
+template <class T>
+std::vector<char> encode_items(const std::vector<T>& values,
+                               void (*encode)(char*, T)) {
+  const size_t stride = sizeof(uint16_t) + sizeof(T);
+  std::vector<char> data(values.size() * stride);
+  char* pos = &data[0];
+  for (size_t i = 0; i < values.size(); ++i) {
+    encode(cass::encode_uint16(pos, sizeof(T)), values[i]);
+    pos += stride;
+  }
+  return data;
+}
+
+void encode_int32(char* output, int32_t value) {
+  cass::encode_int32(output, value);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(serialization)
+
+BOOST_AUTO_TEST_CASE(decode_int32_run)
+{
+  std::vector<int32_t> values;
+  values.push_back(0);
+  values.push_back(1);
+  values.push_back(-1);
+  values.push_back(0x7FFFFFFF);
+  values.push_back(-0x7FFFFFFF - 1);
+  values.push_back(0x01020304);
+
+  std::vector<char> data = encode_items(values, encode_int32);
+  std::vector<int32_t> output(values.size());
+  cass::decode_int32_run(&data[0] + sizeof(uint16_t),
+                         sizeof(uint16_t) + sizeof(int32_t),
+                         values.size(), &output[0]);
+
+  BOOST_CHECK(output == values);
+}
+
+BOOST_AUTO_TEST_CASE(decode_int64_run)
+{
+  std::vector<cass_int64_t> values;
+  values.push_back(0);
+  values.push_back(-1);
+  values.push_back(0x0102030405060708LL);
+  values.push_back(-0x0102030405060708LL);
+
+  std::vector<char> data = encode_items(values, cass::encode_int64);
+  std::vector<cass_int64_t> output(values.size());
+  cass::decode_int64_run(&data[0] + sizeof(uint16_t),
+                         sizeof(uint16_t) + sizeof(cass_int64_t),
+                         values.size(), &output[0]);
+
+  BOOST_CHECK(output == values);
+}
+
+BOOST_AUTO_TEST_CASE(decode_float_and_double_run)
+{
+  std::vector<float> floats;
+  floats.push_back(0.0f);
+  floats.push_back(-1.5f);
+  floats.push_back(3.14159f);
+
+  std::vector<char> data = encode_items(floats, cass::encode_float);
+  std::vector<float> float_output(floats.size());
+  cass::decode_float_run(&data[0] + sizeof(uint16_t),
+                         sizeof(uint16_t) + sizeof(float),
+                         floats.size(), &float_output[0]);
+  BOOST_CHECK(float_output == floats);
+
+  std::vector<double> doubles;
+  doubles.push_back(0.0);
+  doubles.push_back(-1.5);
+  doubles.push_back(2.718281828459045);
+
+  data = encode_items(doubles, cass::encode_double);
+  std::vector<double> double_output(doubles.size());
+  cass::decode_double_run(&data[0] + sizeof(uint16_t),
+                          sizeof(uint16_t) + sizeof(double),
+                          doubles.size(), &double_output[0]);
+  BOOST_CHECK(double_output == doubles);
+}
+
+// A list or set value the way it's decoded from a row
+struct Collection {
+  Collection(CassValueType type, CassValueType primary_type,
+             const std::vector<char>& data, int32_t count)
+    : data(data) {
+    def.type = type;
+    def.collection_primary_type = primary_type;
+    value = cass::Value(&def, count, &this->data[0], this->data.size());
+  }
+
+  const CassValue* get() const { return CassValue::to(&value); }
+
+  cass::ColumnDefinition def;
+  std::vector<char> data;
+  cass::Value value;
+};
+
+BOOST_AUTO_TEST_CASE(get_items)
+{
+  std::vector<int32_t> values;
+  for (int32_t i = 0; i < 10; ++i) {
+    values.push_back(i * 1000 - 5000);
+  }
+  Collection list(CASS_VALUE_TYPE_LIST, CASS_VALUE_TYPE_INT,
+                  encode_items(values, encode_int32), values.size());
+
+  std::vector<cass_int32_t> output(values.size());
+  BOOST_CHECK(cass_value_get_items_int32(list.get(), &output[0],
+                                         output.size()) == values.size());
+  BOOST_CHECK(std::equal(values.begin(), values.end(), output.begin()));
+
+  // At most "count" items are decoded
+  std::fill(output.begin(), output.end(), 0);
+  BOOST_CHECK(cass_value_get_items_int32(list.get(), &output[0], 3) == 3);
+  BOOST_CHECK(std::equal(values.begin(), values.begin() + 3, output.begin()));
+  BOOST_CHECK(output[3] == 0);
+
+  std::vector<cass_int64_t> values64;
+  values64.push_back(-1);
+  values64.push_back(0x7FFFFFFFFFFFFFFFLL);
+  Collection set(CASS_VALUE_TYPE_SET, CASS_VALUE_TYPE_BIGINT,
+                 encode_items(values64, cass::encode_int64), values64.size());
+
+  std::vector<cass_int64_t> output64(values64.size());
+  BOOST_CHECK(cass_value_get_items_int64(set.get(), &output64[0],
+                                         output64.size()) == values64.size());
+  BOOST_CHECK(output64 == values64);
+}
+
+BOOST_AUTO_TEST_CASE(get_items_wrong_type)
+{
+  std::vector<int32_t> values(4, 1);
+  std::vector<char> data = encode_items(values, encode_int32);
+  cass_int64_t output64[4];
+  cass_int32_t output[4];
+
+  // Items of a different type
+  Collection list(CASS_VALUE_TYPE_LIST, CASS_VALUE_TYPE_INT, data, 4);
+  BOOST_CHECK(cass_value_get_items_int64(list.get(), output64, 4) == 0);
+
+  // Maps aren't a run of single items
+  Collection map(CASS_VALUE_TYPE_MAP, CASS_VALUE_TYPE_INT, data, 2);
+  BOOST_CHECK(cass_value_get_items_int32(map.get(), output, 4) == 0);
+
+  // Not a collection
+  cass::Value value(CASS_VALUE_TYPE_INT, &data[0], data.size());
+  BOOST_CHECK(cass_value_get_items_int32(CassValue::to(&value), output, 4) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(get_items_malformed)
+{
+  std::vector<int32_t> values(4, 1);
+  cass_int32_t output[4];
+
+  // The item count doesn't match the size of the data
+  Collection short_list(CASS_VALUE_TYPE_LIST, CASS_VALUE_TYPE_INT,
+                        encode_items(values, encode_int32), 5);
+  BOOST_CHECK(cass_value_get_items_int32(short_list.get(), output, 4) == 0);
+
+  // The total size matches but one item's size prefix doesn't
+  std::vector<char> data = encode_items(values, encode_int32);
+  cass::encode_uint16(&data[2 * (sizeof(uint16_t) + sizeof(int32_t))], 3);
+  Collection list(CASS_VALUE_TYPE_LIST, CASS_VALUE_TYPE_INT, data, 4);
+  BOOST_CHECK(cass_value_get_items_int32(list.get(), output, 4) == 0);
+
+  // Items before the malformed one can still be decoded
+  BOOST_CHECK(cass_value_get_items_int32(list.get(), output, 2) == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
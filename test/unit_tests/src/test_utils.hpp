@@ -0,0 +1,284 @@
+/*
+  Copyright 2014 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#pragma once
+
+#include "request_executor.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+#include "statement.hpp"
+#include "types.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <uv.h>
+
+#include <algorithm>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Builders for the response bodies and a request executor shared by the
+// unit tests
+namespace test_utils {
+
+inline void append_int32(std::string* output, int32_t value) {
+  char buf[sizeof(int32_t)];
+  cass::encode_int32(buf, value);
+  output->append(buf, sizeof(buf));
+}
+
+inline void append_int64(std::string* output, cass_int64_t value) {
+  char buf[sizeof(cass_int64_t)];
+  cass::encode_int64(buf, value);
+  output->append(buf, sizeof(buf));
+}
+
+inline void append_string(std::string* output, const std::string& value) {
+  char buf[sizeof(uint16_t)];
+  cass::encode_uint16(buf, value.size());
+  output->append(buf, sizeof(buf));
+  output->append(value);
+}
+
+inline void append_column(std::string* output, const std::string& name,
+                          uint16_t type) {
+  append_string(output, name);
+  char buf[sizeof(uint16_t)];
+  cass::encode_uint16(buf, type);
+  output->append(buf, sizeof(buf));
+}
+
+// Metadata with a global table spec. The column specs are appended by the
+// caller. A paging state sets the "has more pages" flag.
+inline void append_metadata_header(std::string* output,
+                                   const std::string& keyspace,
+                                   const std::string& table,
+                                   int32_t column_count,
+                                   const std::string& paging_state = std::string()) {
+  int32_t flags = CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
+  if (!paging_state.empty()) flags |= CASS_RESULT_FLAG_HAS_MORE_PAGES;
+  append_int32(output, flags);
+  append_int32(output, column_count);
+  if (!paging_state.empty()) {
+    append_int32(output, paging_state.size());
+    output->append(paging_state);
+  }
+  append_string(output, keyspace);
+  append_string(output, table);
+}
+
+// Metadata of "int" columns named by a comma separated list, e.g. "k,v"
+inline void append_metadata(std::string* output,
+                            const std::string& keyspace,
+                            const std::string& table,
+                            const std::string& columns,
+                            const std::string& paging_state = std::string()) {
+  std::vector<std::string> names;
+  size_t pos = 0;
+  while (pos <= columns.size()) {
+    size_t comma = std::min(columns.find(',', pos), columns.size());
+    names.push_back(columns.substr(pos, comma - pos));
+    pos = comma + 1;
+  }
+
+  append_metadata_header(output, keyspace, table, names.size(), paging_state);
+  for (size_t i = 0; i < names.size(); ++i) {
+    append_column(output, names[i], CASS_VALUE_TYPE_INT);
+  }
+}
+
+// Decodes a copy of "body" that's owned by the result
+inline cass::ResultResponse* decode_result(const std::string& body) {
+  char* buffer = new char[body.size()];
+  memcpy(buffer, body.data(), body.size());
+  cass::ResultResponse* result = new cass::ResultResponse();
+  result->set_buffer(buffer, body.size());
+  BOOST_REQUIRE(result->decode(2, buffer, body.size()));
+  return result;
+}
+
+// A prepared result with "int" bind variables named by "columns". The
+// result metadata has the same columns, e.g. "SELECT v FROM ks.t WHERE
+// v = ?", unless "has_result_metadata" is false, e.g. an INSERT.
+inline cass::ResultResponse* create_prepared_result(const std::string& keyspace,
+                                                    const std::string& table,
+                                                    const std::string& columns,
+                                                    bool has_result_metadata = true) {
+  std::string body;
+  append_int32(&body, CASS_RESULT_KIND_PREPARED);
+  append_string(&body, "0123456789abcdef");
+  append_metadata(&body, keyspace, table, columns);
+  if (has_result_metadata) {
+    append_metadata(&body, keyspace, table, columns);
+  } else {
+    append_int32(&body, 0); // Flags
+    append_int32(&body, 0); // Column count
+  }
+  return decode_result(body);
+}
+
+// A result with a single row whose only column is the "int" column "v"
+inline cass::ResultResponse* create_int_result(int32_t value,
+                                               const std::string& paging_state = std::string()) {
+  std::string body;
+  append_int32(&body, CASS_RESULT_KIND_ROWS);
+  append_metadata(&body, "ks", "t", "v", paging_state);
+  append_int32(&body, 1);
+  append_int32(&body, sizeof(int32_t));
+  append_int32(&body, value);
+  return decode_result(body);
+}
+
+// The value of a result created by create_int_result()
+inline int32_t int_result_value(const cass::ResultResponse* result) {
+  BOOST_REQUIRE(result != NULL);
+  const CassRow* row = cass_result_first_row(CassResult::to(result));
+  cass_int32_t value = -1;
+  BOOST_REQUIRE(cass_value_get_int32(cass_row_get_column(row, 0),
+                                     &value) == CASS_OK);
+  return value;
+}
+
+// The frame of a request encoded into a buffer vector
+inline std::string encode_buffers(const cass::Request* request, int version) {
+  cass::BufferVec bufs;
+  BOOST_REQUIRE(request->encode(version, 0x00, 1, &bufs));
+  std::string frame;
+  for (cass::BufferVec::const_iterator it = bufs.begin(),
+       end = bufs.end(); it != end; ++it) {
+    frame.append(it->encoded_data(), it->encoded_size());
+  }
+  return frame;
+}
+
+// Keeps the requests sent through it, in order, so a test can finish them
+// in any order
+class TestExecutor : public cass::RequestExecutor {
+public:
+  TestExecutor()
+    : in_flight_(0)
+    , max_in_flight_(0)
+    , is_closing_(false)
+    , loop_(NULL)
+    , callback_mode_(CASS_CALLBACK_MODE_WORK_QUEUE) {}
+
+  ~TestExecutor() {
+    for (FutureVec::iterator it = futures_.begin(),
+         end = futures_.end(); it != end; ++it) {
+      if (*it != NULL) (*it)->dec_ref();
+    }
+  }
+
+  virtual cass::Future* execute_internal(const cass::Request* request) {
+    requests_.push_back(RequestPtr(request));
+    threads_.push_back(static_cast<unsigned long>(uv_thread_self()));
+    // Statements are reused for the next page so the paging state is
+    // recorded when the request is sent
+    paging_states_.push_back(
+          static_cast<const cass::Statement*>(request)->paging_state());
+
+    cass::ResponseFuture* future = new cass::ResponseFuture();
+    future->inc_ref(); // External reference
+    future->inc_ref(); // Executor reference
+    future->set_internal();
+    if (loop_ != NULL) {
+      // Like a request handler given to an IO worker running "loop"
+      future->set_loop(loop_);
+      future->set_callback_mode(callback_mode_, NULL);
+    }
+    futures_.push_back(future);
+    max_in_flight_ = std::max(max_in_flight_, ++in_flight_);
+    return future;
+  }
+
+  virtual bool is_closing() const { return is_closing_; }
+
+  void set_closing() { is_closing_ = true; }
+
+  // Futures are set as if by the IO thread running "loop". Without a loop
+  // callbacks run on the thread that sets the future.
+  void set_callback_mode(CassCallbackMode mode, uv_loop_t* loop) {
+    callback_mode_ = mode;
+    loop_ = loop;
+  }
+
+  size_t request_count() const { return requests_.size(); }
+  size_t in_flight() const { return in_flight_; }
+  size_t max_in_flight() const { return max_in_flight_; }
+
+  const cass::Request* request(size_t index) const {
+    return requests_[index].get();
+  }
+
+  const std::string& paging_state(size_t index) const {
+    return paging_states_[index];
+  }
+
+  // The thread that sent the request
+  unsigned long thread(size_t index) const {
+    return threads_[index];
+  }
+
+  // The oldest request that hasn't finished
+  size_t next_pending() const {
+    for (size_t i = 0; i < futures_.size(); ++i) {
+      if (futures_[i] != NULL) return i;
+    }
+    BOOST_FAIL("No pending requests");
+    return futures_.size();
+  }
+
+  // The result is owned by the future. The next request can be sent from
+  // the future's callback.
+  void finish(size_t index, cass::ResultResponse* result) {
+    cass::ResponseFuture* future = release(index);
+    future->set_result(cass::Address(), result);
+    future->dec_ref();
+  }
+
+  void fail(size_t index, CassError code,
+            const std::string& message = "Error") {
+    cass::ResponseFuture* future = release(index);
+    future->set_error(code, message);
+    future->dec_ref();
+  }
+
+private:
+  typedef cass::SharedRefPtr<const cass::Request> RequestPtr;
+  typedef std::vector<cass::ResponseFuture*> FutureVec;
+
+  cass::ResponseFuture* release(size_t index) {
+    BOOST_REQUIRE(index < futures_.size() && futures_[index] != NULL);
+    cass::ResponseFuture* future = futures_[index];
+    futures_[index] = NULL;
+    --in_flight_;
+    return future;
+  }
+
+  std::vector<RequestPtr> requests_;
+  std::vector<std::string> paging_states_;
+  std::vector<unsigned long> threads_;
+  FutureVec futures_;
+  size_t in_flight_;
+  size_t max_in_flight_;
+  bool is_closing_;
+  uv_loop_t* loop_;
+  CassCallbackMode callback_mode_;
+};
+
+} // namespace test_utils